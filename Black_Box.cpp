@@ -0,0 +1,239 @@
+#include "Black_Box.h"
+#include <esp_heap_caps.h>
+#include "Gyro_QMI8658.h"
+#include "SD_Card.h"
+#include "SD_Session.h"
+#include "SD_Async.h"
+
+typedef enum {
+    BLACK_BOX_ARMED = 0,    // watching for a trigger
+    BLACK_BOX_CAPTURE,      // trigger seen, collecting the post-trigger window
+    BLACK_BOX_SAVING        // window handed to the save task
+} BlackBoxState;
+
+static BlackBoxSample *box_ring = NULL;         // PSRAM, written by the driver task only
+static BlackBoxSample *box_copy = NULL;         // PSRAM, the window being saved
+static volatile uint32_t box_head = 0;          // samples added so far; slot = head % BLACK_BOX_SLOTS
+static uint32_t box_pre = 0;                    // window lengths in samples, from the ODR at init
+static uint32_t box_post = 0;
+static volatile BlackBoxState box_state = BLACK_BOX_ARMED;
+static volatile bool box_manual = false;        // Black_Box_Trigger, picked up by the next Black_Box_Add
+static bool box_missed = false;                 // a trigger fired during the current save
+static uint32_t box_trigger_at = 0;             // sample count of the trigger
+static uint32_t box_trigger_us = 0;
+static uint8_t box_trigger = 0;                 // LOG_TRIGGER_*
+static float box_g2_hi = 0, box_g2_lo = 0;      // |a|^2 limits in LSB^2, 0 = off
+static float box_jerk2 = 0;                     // |da|^2 limit per sample in LSB^2, 0 = off
+static int16_t box_last[3];
+static TaskHandle_t box_task = NULL;
+static uint32_t box_session = UINT32_MAX;       // session the event numbers count in
+static uint32_t box_number = 0;                 // next event number within it
+static BlackBoxStats box_stats;
+
+/**
+ * Write box_copy[0..n) as an event log: header, then full blocks, packed like the session log.
+ */
+static bool Black_Box_Write(const char *path, uint32_t n)
+{
+    uint8_t *block = (uint8_t *)heap_caps_malloc(SD_LOG_BLOCK, MALLOC_CAP_SPIRAM);
+    FILE *f = block ? fopen(path, "wb") : NULL;
+    if (!f) {
+        heap_caps_free(block);
+        return false;
+    }
+
+    LogHeader h;
+    Log_Header_Init(&h, QMI8658_Acc_LSB_G(), 0, QMI8658_Acc_ODR_Hz(), box_copy[0].t_us, esp_random(), SD_LOG_BLOCK);
+    h.flags |= LOG_FLAG_EVENT | (SD_LOG_PACK ? LOG_FLAG_PACKED : 0);
+    h.trigger = box_trigger;
+    h.trigger_us = box_trigger_us;
+    strncpy(h.device, "ESP32-S3 GForce", LOG_DEVICE_LEN - 1);
+    Log_Header_Seal(&h);
+    bool ok = fwrite(&h, 1, sizeof(h), f) == sizeof(h);
+
+    uint32_t last_us = h.start_us, seq = 0, i = 0;
+    while (ok && i < n) {
+        uint8_t *payload = block + sizeof(LogBlockHeader);
+        uint32_t len = 0;
+        LogPacker p;
+        if (SD_LOG_PACK) Log_Pack_Begin(&p, payload, SD_LOG_BLOCK - sizeof(LogBlockHeader));
+        for (; i < n; i++) {
+            LogRecord r;
+            uint32_t prev_us = last_us;
+            Log_Record_Pack(&r, &last_us, box_copy[i].t_us, box_copy[i].accel, NULL);
+            if (SD_LOG_PACK ? !Log_Pack_Add(&p, &r) : len + sizeof(r) > SD_LOG_BLOCK - sizeof(LogBlockHeader)) {
+                last_us = prev_us;                  // goes into the next block
+                break;
+            }
+            if (!SD_LOG_PACK) memcpy(payload + len, &r, sizeof(r));
+            len += sizeof(r);
+        }
+        if (SD_LOG_PACK) len = Log_Pack_End(&p);
+        memset(payload + len, 0, SD_LOG_BLOCK - sizeof(LogBlockHeader) - len);
+        Log_Block_Seal(block, h.session, seq++, len);
+        ok = fwrite(block, 1, SD_LOG_BLOCK, f) == SD_LOG_BLOCK;
+    }
+    ok = fclose(f) == 0 && ok;
+    heap_caps_free(block);
+    return ok;
+}
+
+// Waits for a finished capture, copies it out of the ring before the ring laps it, saves it
+static void Black_Box_Task(void *parameter)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint32_t start = box_trigger_at > box_pre ? box_trigger_at - box_pre : 0;
+        uint32_t end = box_trigger_at + box_post;
+        for (uint32_t k = start; k < end; k++) box_copy[k - start] = box_ring[k & (BLACK_BOX_SLOTS - 1)];
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (box_head - start > BLACK_BOX_SLOTS) {   // the driver task overwrote part of it while we copied
+            box_stats.overruns++;
+            printf("Black box: event lost, save started too late\r\n");
+            box_state = BLACK_BOX_ARMED;
+            continue;
+        }
+
+        uint32_t number;
+        if (!SD_Session_Number(&number)) number = 0;
+        if (number != box_session) {
+            box_session = number;
+            box_number = 0;
+        }
+        char path[48];
+        do {    // never overwrite an event, e.g. one saved under the same number before a reboot
+            snprintf(path, sizeof(path), SD_MOUNT_POINT BLACK_BOX_NAME_FMT, (unsigned long)number,
+                     (unsigned long)box_number++);
+        } while (SD_Async_Size_Wait(path) >= 0);
+        uint32_t t0 = millis();
+        bool ok = Black_Box_Write(path, end - start);
+        SD_Async_Invalidate(path);                  // written outside the file service
+        box_stats.write_ms = millis() - t0;
+        if (ok) box_stats.events++;
+        printf("Black box: %s %s, %lu samples in %lu ms\r\n", ok ? "saved" : "cannot write", path,
+               (unsigned long)(end - start), (unsigned long)box_stats.write_ms);
+        box_state = BLACK_BOX_ARMED;
+    }
+}
+
+/**
+ * Set the automatic triggers.
+ * @param g            distance of |a| from 1 g that fires, 0 = off
+ * @param jerk_g_per_s magnitude of the change of a between two samples, per second, that fires; 0 = off
+ */
+void Black_Box_Set_Trigger(float g, float jerk_g_per_s)
+{
+    float lsb = QMI8658_Acc_LSB_G();
+    float hi = (1.0f + g) / lsb, lo = g < 1.0f ? (1.0f - g) / lsb : 0.0f;
+    float jerk = jerk_g_per_s / QMI8658_Acc_ODR_Hz() / lsb;
+    box_g2_hi = g > 0 ? hi * hi : 0;
+    box_g2_lo = g > 0 ? lo * lo : 0;
+    box_jerk2 = jerk_g_per_s > 0 ? jerk * jerk : 0;
+}
+
+/**
+ * Allocate the ring and start the save task. The window lengths follow the accelerometer ODR,
+ * so call after the sensor is configured.
+ */
+bool Black_Box_Init(void)
+{
+    float odr = QMI8658_Acc_ODR_Hz();
+    box_pre = (uint32_t)(BLACK_BOX_PRE_MS * odr / 1000);
+    box_post = (uint32_t)(BLACK_BOX_POST_MS * odr / 1000);
+    if (box_pre + box_post + odr / 2 > BLACK_BOX_SLOTS) {     // keep at least half a second to start the save
+        box_pre = BLACK_BOX_SLOTS / 2;
+        box_post = BLACK_BOX_SLOTS / 4;
+        printf("Black box: window clamped to %lu + %lu samples at %.0f Hz\r\n", (unsigned long)box_pre,
+               (unsigned long)box_post, odr);
+    }
+    box_copy = (BlackBoxSample *)heap_caps_malloc((box_pre + box_post) * sizeof(BlackBoxSample), MALLOC_CAP_SPIRAM);
+    BlackBoxSample *ring = (BlackBoxSample *)heap_caps_malloc(BLACK_BOX_SLOTS * sizeof(BlackBoxSample), MALLOC_CAP_SPIRAM);
+    if (!box_copy || !ring ||
+        xTaskCreatePinnedToCore(Black_Box_Task, "Black Box", 4096, NULL, BLACK_BOX_TASK_PRIORITY, &box_task,
+                                BLACK_BOX_TASK_CORE) != pdPASS) {
+        printf("Black box: out of memory\r\n");
+        heap_caps_free(box_copy);
+        heap_caps_free(ring);
+        box_copy = NULL;
+        return false;
+    }
+    Black_Box_Set_Trigger(BLACK_BOX_G_TRIGGER, BLACK_BOX_JERK_TRIGGER);
+    memset(&box_stats, 0, sizeof(box_stats));
+    __atomic_store_n(&box_ring, ring, __ATOMIC_RELEASE);    // Black_Box_Add starts filling from here
+    return true;
+}
+
+// Trigger test for one sample against the previous one, in LSB; 0 when nothing fired
+static inline uint8_t Black_Box_Check(const int16_t a[3], bool first)
+{
+    float g2 = (float)a[0] * a[0] + (float)a[1] * a[1] + (float)a[2] * a[2];
+    if (box_g2_hi > 0 && (g2 > box_g2_hi || g2 < box_g2_lo)) return LOG_TRIGGER_G;
+    float d[3] = {(float)(a[0] - box_last[0]), (float)(a[1] - box_last[1]), (float)(a[2] - box_last[2])};
+    if (box_jerk2 > 0 && !first && d[0] * d[0] + d[1] * d[1] + d[2] * d[2] > box_jerk2) return LOG_TRIGGER_JERK;
+    return 0;
+}
+
+/**
+ * Add one FIFO read to the ring and run the triggers on every sample. Driver task only.
+ * @param first_us  sample clock time of the oldest sample, from IMU_Clock_Stamp
+ * @param step_us   time between consecutive samples of this read
+ */
+void Black_Box_Add(const int16_t (*raw)[3], uint16_t n, uint32_t first_us, uint32_t step_us)
+{
+    BlackBoxSample *ring = __atomic_load_n(&box_ring, __ATOMIC_ACQUIRE);
+    if (!ring) return;
+
+    uint32_t head = box_head;
+    for (uint16_t i = 0; i < n; i++, head++) {
+        BlackBoxSample *s = &ring[head & (BLACK_BOX_SLOTS - 1)];
+        s->t_us = first_us + i * step_us;
+        memcpy(s->accel, raw[i], sizeof(s->accel));
+
+        if (box_state == BLACK_BOX_ARMED) {
+            uint8_t fired = box_manual ? LOG_TRIGGER_MANUAL : Black_Box_Check(raw[i], head == 0);
+            if (fired) {
+                box_manual = false;
+                box_missed = false;
+                box_trigger = fired;
+                box_trigger_at = head;
+                box_trigger_us = s->t_us;
+                box_state = BLACK_BOX_CAPTURE;
+            }
+        } else if (box_manual || (box_state == BLACK_BOX_SAVING && Black_Box_Check(raw[i], false))) {
+            box_manual = false;                     // a capture in progress already covers this one
+            if (box_state == BLACK_BOX_SAVING && !box_missed) {
+                box_missed = true;
+                box_stats.missed++;
+            }
+        }
+        memcpy(box_last, raw[i], sizeof(box_last));
+    }
+    __atomic_store_n(&box_head, head, __ATOMIC_RELEASE);
+
+    if (box_state == BLACK_BOX_CAPTURE && head - box_trigger_at >= box_post) {
+        box_state = BLACK_BOX_SAVING;
+        xTaskNotifyGive(box_task);
+    }
+}
+
+/**
+ * Capture an event around the next sample, as if a trigger had fired. Safe from any task.
+ */
+void Black_Box_Trigger(void)
+{
+    box_manual = true;
+}
+
+void Black_Box_Get_Stats(BlackBoxStats *out)
+{
+    *out = box_stats;
+}
+
+void Black_Box_Print(void)
+{
+    static const char *const state[] = {"armed", "capturing", "saving"};
+    BlackBoxStats s = box_stats;
+    printf("Black box: %s, %lu + %lu samples around a trigger, %lu events, %lu missed, %lu lost, last save %lu ms\r\n",
+           box_ring ? state[box_state] : "off", (unsigned long)box_pre, (unsigned long)box_post,
+           (unsigned long)s.events, (unsigned long)s.missed, (unsigned long)s.overruns, (unsigned long)s.write_ms);
+}
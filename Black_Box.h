@@ -0,0 +1,35 @@
+#pragma once
+#include <Arduino.h>
+#include "Log_Format.h"
+
+// Event capture: the last BLACK_BOX_SLOTS full-rate samples stay in a PSRAM ring, and when a
+// trigger fires the window from BLACK_BOX_PRE_MS before to BLACK_BOX_POST_MS after it is
+// written to its own log file next to the session log (LOG_FLAG_EVENT, same format).
+// The session log can then run decimated (SD_LOG_DIVIDER) while events keep every sample.
+#define BLACK_BOX_SLOTS         8192    // samples kept, power of two; 8.2 s at 1 kHz
+#define BLACK_BOX_PRE_MS        3000    // history saved before the trigger
+#define BLACK_BOX_POST_MS       2000    // and after it; the rest of the ring is time for the save to start
+#define BLACK_BOX_G_TRIGGER     2.5f    // fire when |a| is this far from 1 g, 0 = off
+#define BLACK_BOX_JERK_TRIGGER  500.0f  // fire when the change of a between two samples exceeds this, in g/s, 0 = off
+#define BLACK_BOX_NAME_FMT      SD_SESSION_DIR "/s%05lu_e%03lu.log"  // session number, event number
+#define BLACK_BOX_TASK_CORE     0
+#define BLACK_BOX_TASK_PRIORITY 1       // with the SD log tasks
+
+typedef struct {
+    uint32_t t_us;          // sample clock (IMU_Clock_Stamp), strictly increasing through the ring
+    int16_t accel[3];       // LSB of the live accelerometer range
+} BlackBoxSample;
+
+typedef struct {
+    uint32_t events;        // event files written
+    uint32_t missed;        // saves during which a new trigger fired and was ignored
+    uint32_t overruns;      // events lost because the save started too late and the ring had moved on
+    uint32_t write_ms;      // time the last save took
+} BlackBoxStats;
+
+bool Black_Box_Init(void);
+void Black_Box_Add(const int16_t (*raw)[3], uint16_t n, uint32_t first_us, uint32_t step_us);
+void Black_Box_Trigger(void);
+void Black_Box_Set_Trigger(float g, float jerk_g_per_s);
+void Black_Box_Get_Stats(BlackBoxStats *out);
+void Black_Box_Print(void);
@@ -2,10 +2,17 @@
 #include <esp_lcd_panel_rgb.h>
 #include <driver/ledc.h>
 #include "LVGL_Driver.h"  // only for panel_handle
+#include "Latency_Trace.h"
 
 // Global handle visible to LVGL
 esp_lcd_panel_handle_t panel_handle = NULL;
 
+// Start of each scan-out, from the RGB panel ISR
+IRAM_ATTR bool example_on_vsync_event(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t *event_data, void *user_data) {
+    Latency_Trace_Vsync();
+    return false;   // no task woken
+}
+
 void LCD_Init() {
     Serial.println("LCD_Init: Starting ST7701 RGB setup...");
 
@@ -61,6 +68,11 @@ void LCD_Init() {
     ESP_ERROR_CHECK(esp_lcd_panel_reset(panel_handle));
     ESP_ERROR_CHECK(esp_lcd_panel_init(panel_handle));
 
+    esp_lcd_rgb_panel_event_callbacks_t cbs = {
+        .on_vsync = example_on_vsync_event,
+    };
+    ESP_ERROR_CHECK(esp_lcd_rgb_panel_register_event_callbacks(panel_handle, &cbs, NULL));
+
     Serial.println("LCD_Init: RGB panel initialized.");
 
     // --- Backlight setup ---
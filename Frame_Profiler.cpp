@@ -0,0 +1,217 @@
+#include "Frame_Profiler.h"
+#include <esp_freertos_hooks.h>
+#include "Display_ST7701.h"
+#include "LVGL_Driver.h"
+
+#define IDLE_GAP_US     50      // idle hook calls closer together than this count as idle time
+
+static FrameProfile ring[FRAME_PROFILER_LEN];
+static uint16_t ring_head = 0;              // next slot to write
+static uint16_t ring_count = 0;
+static FrameProfile current;
+static uint32_t frame_start_us;
+
+static volatile uint32_t idle_us[2];
+static uint32_t idle_last_us[2];
+static uint32_t idle_at_start[2];
+static bool idle_hooked = false;           // idle hooks registered, only while the overlay is shown
+static bool idle_hooked_at_start = false;  // the current frame's idle time is complete if both are set
+
+static lv_obj_t *overlay = NULL;
+static uint32_t overlay_update_ms = 0;
+#if EXAMPLE_ENABLE_PRINT_LCD_FPS
+static uint32_t print_ms = 0;
+#endif
+
+/**
+ * FreeRTOS idle hook: while a core is idle the hook is called back to back,
+ * so the short gaps between calls add up to its idle time.
+ * Returning false keeps the idle task spinning instead of waiting for an interrupt,
+ * which costs power and light sleep, so the hooks are only registered while
+ * the overlay is shown.
+ */
+static bool Frame_Profiler_Idle(int core)
+{
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    uint32_t gap = now - idle_last_us[core];
+    if (gap < IDLE_GAP_US) idle_us[core] += gap;
+    idle_last_us[core] = now;
+    return false;
+}
+static bool Frame_Profiler_Idle_Core0(void) { return Frame_Profiler_Idle(0); }
+static bool Frame_Profiler_Idle_Core1(void) { return Frame_Profiler_Idle(1); }
+
+static void Frame_Profiler_Hook_Idle(bool on)
+{
+    if (on == idle_hooked) return;
+    if (on) {
+        esp_register_freertos_idle_hook_for_cpu(Frame_Profiler_Idle_Core0, 0);
+        esp_register_freertos_idle_hook_for_cpu(Frame_Profiler_Idle_Core1, 1);
+    } else {
+        esp_deregister_freertos_idle_hook_for_cpu(Frame_Profiler_Idle_Core0, 0);
+        esp_deregister_freertos_idle_hook_for_cpu(Frame_Profiler_Idle_Core1, 1);
+    }
+    idle_hooked = on;
+}
+
+/**
+ * Replacement callback of the display refresh timer: times LVGL's refresh and
+ * subtracts the flush time reported from inside it.
+ */
+static void Frame_Profiler_Refr_Timer(lv_timer_t *timer)
+{
+    uint32_t flush_before = current.flush_us;
+    uint32_t start = micros();
+    _lv_disp_refr_timer(timer);
+    uint32_t elapsed = micros() - start;
+    current.refr_us += elapsed - (current.flush_us - flush_before);
+}
+
+void Frame_Profiler_Init(void)
+{
+    memset(&current, 0, sizeof(current));
+    lv_timer_set_cb(_lv_disp_get_refr_timer(lv_disp_get_default()), Frame_Profiler_Refr_Timer);
+    overlay = lv_label_create(lv_layer_top());
+    lv_obj_set_style_bg_color(overlay, lv_color_hex(0x000000), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(overlay, LV_OPA_60, LV_PART_MAIN);
+    lv_obj_set_style_text_color(overlay, lv_color_hex(0x00FF00), LV_PART_MAIN);
+    lv_obj_set_style_pad_all(overlay, 4, LV_PART_MAIN);
+    lv_obj_align(overlay, LV_ALIGN_TOP_MID, 0, 60);
+    lv_label_set_text(overlay, "");
+    lv_obj_add_flag(overlay, LV_OBJ_FLAG_HIDDEN);
+}
+
+void Frame_Profiler_Frame_Begin(void)
+{
+    current.t_ms = millis();
+    frame_start_us = micros();
+    idle_at_start[0] = idle_us[0];
+    idle_at_start[1] = idle_us[1];
+    idle_hooked_at_start = idle_hooked;
+}
+
+/**
+ * Called from the flush callback.
+ * @param flush_us time taken by the flush
+ * @param px       pixels in the flushed area
+ */
+void Frame_Profiler_Flush(uint32_t flush_us, uint32_t px)
+{
+    current.flush_us += flush_us;
+    current.dirty_px += px;
+}
+
+/**
+ * cpu_load as text, none if the frame was not measured.
+ */
+static const char *Frame_Profiler_Load_Str(char *buf, size_t len, uint8_t load, const char *none)
+{
+    if (load == FRAME_PROFILER_NO_LOAD) return none;
+    snprintf(buf, len, "%u", load);
+    return buf;
+}
+
+/**
+ * Show the average of the last second of frames on the overlay.
+ */
+static void Frame_Profiler_Update_Overlay(void)
+{
+    uint32_t n = 0, refr = 0, flush = 0, handler = 0, px = 0;
+    uint32_t now = millis();
+    for (uint16_t i = 1; i <= ring_count; i++) {
+        const FrameProfile *f = &ring[(ring_head + FRAME_PROFILER_LEN - i) % FRAME_PROFILER_LEN];
+        if (now - f->t_ms > 1000) break;
+        refr += f->refr_us;
+        flush += f->flush_us;
+        handler += f->handler_us;
+        px += f->dirty_px;
+        n++;
+    }
+    if (!n) return;
+    const FrameProfile *last = &ring[(ring_head + FRAME_PROFILER_LEN - 1) % FRAME_PROFILER_LEN];
+    char load0[4], load1[4];
+    lv_label_set_text_fmt(overlay, "%lu fps  px %lu\nrefr %lu us  flush %lu us\nlvgl %lu us\ncpu0 %s%%  cpu1 %s%%",
+                          n, px / n, refr / n, flush / n, handler / n,
+                          Frame_Profiler_Load_Str(load0, sizeof(load0), last->cpu_load[0], "--"),
+                          Frame_Profiler_Load_Str(load1, sizeof(load1), last->cpu_load[1], "--"));
+}
+
+/**
+ * Close the current frame record and push it into the ring.
+ * @param handler_us lv_timer_handler duration measured by the scheduler
+ */
+void Frame_Profiler_Frame_End(uint32_t handler_us)
+{
+    uint32_t elapsed = micros() - frame_start_us;
+    bool measured = idle_hooked && idle_hooked_at_start && elapsed;
+    for (int core = 0; core < 2; core++) {
+        uint32_t idle = idle_us[core] - idle_at_start[core];
+        current.cpu_load[core] = measured ? 100 - min(idle * 100 / elapsed, (uint32_t)100) : FRAME_PROFILER_NO_LOAD;
+    }
+    current.handler_us = handler_us;
+
+    ring[ring_head] = current;
+    ring_head = (ring_head + 1) % FRAME_PROFILER_LEN;
+    if (ring_count < FRAME_PROFILER_LEN) ring_count++;
+    memset(&current, 0, sizeof(current));
+
+    uint32_t now = millis();
+    if (!lv_obj_has_flag(overlay, LV_OBJ_FLAG_HIDDEN) && now - overlay_update_ms >= FRAME_PROFILER_OVERLAY_MS) {
+        overlay_update_ms = now;
+        Frame_Profiler_Update_Overlay();
+    }
+#if EXAMPLE_ENABLE_PRINT_LCD_FPS
+    if (now - print_ms >= 1000) {
+        print_ms = now;
+        const FrameProfile *f = &ring[(ring_head + FRAME_PROFILER_LEN - 1) % FRAME_PROFILER_LEN];
+        char load0[4], load1[4];
+        printf("Frame: refr %lu us, flush %lu us, lvgl %lu us, %lu px, cpu %s%%/%s%%\r\n",
+               f->refr_us, f->flush_us, f->handler_us, f->dirty_px,
+               Frame_Profiler_Load_Str(load0, sizeof(load0), f->cpu_load[0], "-"),
+               Frame_Profiler_Load_Str(load1, sizeof(load1), f->cpu_load[1], "-"));
+    }
+#endif
+}
+
+void Frame_Profiler_Toggle_Overlay(void)
+{
+    lvgl_lock();
+    if (lv_obj_has_flag(overlay, LV_OBJ_FLAG_HIDDEN)) {
+        lv_obj_clear_flag(overlay, LV_OBJ_FLAG_HIDDEN);
+        Frame_Profiler_Hook_Idle(true);
+        Frame_Profiler_Update_Overlay();
+    } else {
+        lv_obj_add_flag(overlay, LV_OBJ_FLAG_HIDDEN);
+        Frame_Profiler_Hook_Idle(false);
+    }
+    lvgl_unlock();
+}
+
+/**
+ * Print the ring, oldest frame first, as CSV. The ring is copied under the
+ * LVGL lock so printing does not hold up rendering. cpu0/cpu1 are empty for
+ * frames recorded while the overlay was hidden.
+ */
+void Frame_Profiler_Dump_CSV(void)
+{
+    FrameProfile *copy = (FrameProfile *)malloc(sizeof(ring));
+    if (!copy) {
+        printf("Profiler: out of memory\r\n");
+        return;
+    }
+    lvgl_lock();
+    memcpy(copy, ring, sizeof(ring));
+    uint16_t head = ring_head;
+    uint16_t count = ring_count;
+    lvgl_unlock();
+
+    printf("t_ms,refr_us,flush_us,handler_us,dirty_px,cpu0,cpu1\r\n");
+    for (uint16_t i = count; i > 0; i--) {
+        const FrameProfile *f = &copy[(head + FRAME_PROFILER_LEN - i) % FRAME_PROFILER_LEN];
+        char load0[4], load1[4];
+        printf("%lu,%lu,%lu,%lu,%lu,%s,%s\r\n", f->t_ms, f->refr_us, f->flush_us, f->handler_us, f->dirty_px,
+               Frame_Profiler_Load_Str(load0, sizeof(load0), f->cpu_load[0], ""),
+               Frame_Profiler_Load_Str(load1, sizeof(load1), f->cpu_load[1], ""));
+    }
+    free(copy);
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+
+#define FRAME_PROFILER_LEN          256     // frames kept in the ring
+#define FRAME_PROFILER_OVERLAY_MS   500     // overlay refresh period
+#define FRAME_PROFILER_NO_LOAD      0xFF    // cpu_load of a frame not measured (overlay hidden)
+
+// Timings of one scheduler frame. LVGL refreshes that happen between frames
+// (animations, input) are added to the following frame.
+typedef struct {
+    uint32_t t_ms;          // frame start, millis()
+    uint32_t refr_us;       // LVGL rendering, flush excluded
+    uint32_t flush_us;      // time spent in the flush callback
+    uint32_t handler_us;    // lv_timer_handler duration
+    uint32_t dirty_px;      // pixels rendered and flushed
+    uint8_t cpu_load[2];    // % busy per core over the frame, FRAME_PROFILER_NO_LOAD while the overlay is hidden
+} FrameProfile;
+
+void Frame_Profiler_Init(void);
+void Frame_Profiler_Frame_Begin(void);
+void Frame_Profiler_Frame_End(uint32_t handler_us);
+void Frame_Profiler_Flush(uint32_t flush_us, uint32_t px);
+void Frame_Profiler_Toggle_Overlay(void);
+void Frame_Profiler_Dump_CSV(void);
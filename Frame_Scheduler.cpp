@@ -0,0 +1,164 @@
+#include "Frame_Scheduler.h"
+#include "Frame_Profiler.h"
+#include "Latency_Trace.h"
+
+FrameStats frame_stats;
+
+static Frame_Update_cb update_cb = NULL;
+static Frame_Tick_cb tick_cb = NULL;
+static uint32_t lvgl_us_avg = 0;    // running average of render + flush, for the scan-out estimate
+static uint32_t frame_period_us;
+static uint32_t next_frame_us;
+static uint32_t next_lvgl_us;
+static uint32_t last_seq = 0;
+static uint32_t report_start_ms;
+static volatile bool paused = false;
+
+/**
+ * Drive LVGL at a fixed frame rate.
+ * @param fps    target frames per second
+ * @param update called at frame start with the latest sample, only when it is new
+ */
+void Frame_Scheduler_Init(uint16_t fps, Frame_Update_cb update)
+{
+    update_cb = update;
+    Frame_Scheduler_Set_FPS(fps);
+    next_frame_us = micros();
+    next_lvgl_us = next_frame_us;
+    report_start_ms = millis();
+    memset(&frame_stats, 0, sizeof(frame_stats));
+}
+
+/**
+ * Change the target frame rate. LVGL's display refresh timer is set to the
+ * same period so renders line up with frames.
+ */
+void Frame_Scheduler_Set_FPS(uint16_t fps)
+{
+    if (fps == 0) fps = 1;
+    frame_period_us = 1000000UL / fps;
+    lv_disp_t *disp = lv_disp_get_default();
+    if (disp) lv_timer_set_period(_lv_disp_get_refr_timer(disp), frame_period_us / 1000);
+}
+
+/**
+ * Register a callback run on every frame, new sample or not, with the time the
+ * frame is expected to become visible. Used to animate between samples.
+ */
+void Frame_Scheduler_Set_Tick(Frame_Tick_cb tick)
+{
+    tick_cb = tick;
+}
+
+/**
+ * Run the frame tick callback, if any.
+ * @param present_us time the frame becomes visible, micros()
+ * @return true if the frame needs rendering
+ */
+bool Frame_Scheduler_Tick(uint32_t present_us)
+{
+    return tick_cb && tick_cb(present_us);
+}
+
+/**
+ * Stop driving the screen: while paused the loop neither pulls samples, runs
+ * the tick callback nor calls lv_timer_handler, so whoever paused it owns the
+ * widgets even between LVGL lock holds. On resume the latest sample is applied
+ * again on the next frame, whether or not it is new. Call with the LVGL lock held.
+ */
+void Frame_Scheduler_Pause(bool pause)
+{
+    paused = pause;
+    if (pause) return;
+    last_seq = 0;
+    next_frame_us = micros();
+    next_lvgl_us = next_frame_us;
+}
+
+/**
+ * Run whatever is due: the frame (sample pull, widget update, forced refresh)
+ * and/or LVGL's own timers.
+ * @return ms until the scheduler needs to run again
+ */
+uint32_t Frame_Scheduler_Loop(void)
+{
+    if (paused) return frame_period_us / 1000;
+
+    uint32_t now = micros();
+    bool frame_due = (int32_t)(now - next_frame_us) >= 0;
+
+    uint32_t update_us = 0;
+    if (frame_due) {
+        IMUSample sample;
+        bool render = false;
+        Frame_Profiler_Frame_Begin();
+        frame_stats.frames++;
+        if (update_cb && IMU_Sample_Latest(&sample) && sample.seq != last_seq) {
+            last_seq = sample.seq;
+            update_cb(&sample);
+            Latency_Trace_Update(&sample);
+            render = true;
+        } else {
+            frame_stats.skipped++;
+        }
+        if (Frame_Scheduler_Tick(now + lvgl_us_avg + FRAME_SCANOUT_US)) render = true;
+        // Render this frame now rather than at the refresh timer's own phase
+        if (render) lv_timer_ready(_lv_disp_get_refr_timer(lv_disp_get_default()));
+        update_us = micros() - now;
+        frame_stats.update_us_sum += update_us;
+        frame_stats.update_us_max = max(frame_stats.update_us_max, update_us);
+    }
+
+    if (frame_due || (int32_t)(now - next_lvgl_us) >= 0) {
+        uint32_t start = micros();
+        uint32_t lvgl_wait_ms = lv_timer_handler();
+        uint32_t end = micros();
+        next_lvgl_us = end + lvgl_wait_ms * 1000;
+        if (frame_due) {
+            uint32_t lvgl_us = end - start;
+            lvgl_us_avg += ((int32_t)lvgl_us - (int32_t)lvgl_us_avg) / 8;
+            frame_stats.lvgl_us_sum += lvgl_us;
+            frame_stats.lvgl_us_max = max(frame_stats.lvgl_us_max, lvgl_us);
+            Frame_Profiler_Frame_End(lvgl_us);
+        }
+    }
+
+    if (frame_due) {
+        next_frame_us += frame_period_us;
+        now = micros();
+        if ((int32_t)(now - next_frame_us) >= 0) {     // overran: drop the missed frames
+            frame_stats.late++;
+            next_frame_us = now + frame_period_us;
+        }
+    }
+
+#if FRAME_REPORT_MS
+    if (millis() - report_start_ms >= FRAME_REPORT_MS) {
+        Frame_Scheduler_Report();
+        memset(&frame_stats, 0, sizeof(frame_stats));
+        report_start_ms = millis();
+    }
+#endif
+
+    now = micros();
+    int32_t to_frame = (int32_t)(next_frame_us - now);
+    int32_t to_lvgl = (int32_t)(next_lvgl_us - now);
+    int32_t wait_us = min(to_frame, to_lvgl);
+    return wait_us > 0 ? wait_us / 1000 : 0;
+}
+
+/**
+ * Print the frame-time budget used by each stage over the current window.
+ */
+void Frame_Scheduler_Report(void)
+{
+    uint32_t frames = frame_stats.frames ? frame_stats.frames : 1;
+    uint32_t update_avg = frame_stats.update_us_sum / frames;
+    uint32_t lvgl_avg = frame_stats.lvgl_us_sum / frames;
+    printf("Frame: %lu fps target, %lu frames, %lu skipped, %lu late\r\n",
+           1000000UL / frame_period_us, frame_stats.frames, frame_stats.skipped, frame_stats.late);
+    printf("  update avg %lu us max %lu us (%lu%% budget)\r\n",
+           update_avg, frame_stats.update_us_max, update_avg * 100 / frame_period_us);
+    printf("  lvgl   avg %lu us max %lu us (%lu%% budget)\r\n",
+           lvgl_avg, frame_stats.lvgl_us_max, lvgl_avg * 100 / frame_period_us);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+#include "IMU_Sample.h"
+
+#define FRAME_TARGET_FPS    30      // UI frames per second
+#define FRAME_REPORT_MS     5000    // period of the budget report on Serial, 0 = off
+#define FRAME_SCANOUT_US    8500    // flush to visible: half a panel refresh (16 MHz pclk, 520x520 total, ~59 Hz)
+
+typedef void (*Frame_Update_cb)(const IMUSample *sample);
+typedef bool (*Frame_Tick_cb)(uint32_t present_us);     // return true if the frame needs rendering
+
+// Per-stage timings accumulated over one report window
+typedef struct {
+    uint32_t frames;            // frames started
+    uint32_t skipped;           // frames without a new sample (update stage skipped)
+    uint32_t late;              // frames that overran their budget
+    uint32_t update_us_sum;     // widget update stage
+    uint32_t update_us_max;
+    uint32_t lvgl_us_sum;       // lv_timer_handler (render + flush)
+    uint32_t lvgl_us_max;
+} FrameStats;
+
+extern FrameStats frame_stats;
+
+void Frame_Scheduler_Init(uint16_t fps, Frame_Update_cb update);
+void Frame_Scheduler_Set_FPS(uint16_t fps);
+void Frame_Scheduler_Set_Tick(Frame_Tick_cb tick);
+bool Frame_Scheduler_Tick(uint32_t present_us);
+void Frame_Scheduler_Pause(bool pause);
+uint32_t Frame_Scheduler_Loop(void);
+void Frame_Scheduler_Report(void);
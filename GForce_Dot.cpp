@@ -0,0 +1,152 @@
+#include "GForce_Dot.h"
+#include <Arduino.h>
+#include <string.h>
+
+#define DOT_MAX_W   64      // largest sprite supported, px
+#define DOT_MAX_H   64
+
+static lv_obj_t *dot_img = NULL;
+static const lv_img_dsc_t *dot_sprite = NULL;
+static lv_img_dsc_t dot_dsc;                        // sprite shifted by the sub-pixel phase, 1 px larger
+static uint8_t dot_buf[(DOT_MAX_W + 1) * (DOT_MAX_H + 1) * LV_IMG_PX_SIZE_ALPHA_BYTE];
+
+// Last two samples, in 1/16 px
+static int32_t prev_x, prev_y, last_x, last_y;
+static uint32_t prev_t, last_t;
+static uint8_t samples = 0;
+static int32_t shown_x = INT32_MIN, shown_y = INT32_MIN;
+static uint8_t shown_fx = 0, shown_fy = 0;                // phase currently in dot_buf
+
+/**
+ * Resample the sprite shifted right/down by fx/16, fy/16 px into dot_buf.
+ * Bilinear with premultiplied alpha, so the edge keeps its colour as it fades.
+ */
+static void GForce_Dot_Shift(uint8_t fx, uint8_t fy)
+{
+    const uint8_t *src = dot_sprite->data;
+    lv_coord_t sw = dot_sprite->header.w, sh = dot_sprite->header.h;
+    lv_coord_t dw = sw + 1, dh = sh + 1;
+    uint32_t w[4] = {(uint32_t)(GFORCE_DOT_SUBPX - fx) * (GFORCE_DOT_SUBPX - fy),   // (x,   y)
+                     (uint32_t)fx * (GFORCE_DOT_SUBPX - fy),                        // (x-1, y)
+                     (uint32_t)(GFORCE_DOT_SUBPX - fx) * fy,                        // (x,   y-1)
+                     (uint32_t)fx * fy};                                            // (x-1, y-1)
+    uint8_t *out = dot_buf;
+
+    for (lv_coord_t y = 0; y < dh; y++) {
+        for (lv_coord_t x = 0; x < dw; x++, out += LV_IMG_PX_SIZE_ALPHA_BYTE) {
+            uint32_t a_sum = 0, r_sum = 0, g_sum = 0, b_sum = 0;
+            for (uint8_t k = 0; k < 4; k++) {
+                lv_coord_t sx = x - (k & 1), sy = y - (k >> 1);
+                if (!w[k] || sx < 0 || sy < 0 || sx >= sw || sy >= sh) continue;
+                const uint8_t *p = src + (sy * sw + sx) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+                uint32_t aw = p[2] * w[k];
+                if (!aw) continue;
+                uint16_t c = (uint16_t)(p[0] | (p[1] << 8));
+                a_sum += aw;
+                r_sum += (c >> 11) * aw;
+                g_sum += ((c >> 5) & 0x3F) * aw;
+                b_sum += (c & 0x1F) * aw;
+            }
+            if (!a_sum) {
+                out[0] = out[1] = out[2] = 0;
+                continue;
+            }
+            uint16_t c = (uint16_t)(((r_sum / a_sum) << 11) | ((g_sum / a_sum) << 5) | (b_sum / a_sum));
+            out[0] = c & 0xFF;
+            out[1] = c >> 8;
+            out[2] = a_sum / (GFORCE_DOT_SUBPX * GFORCE_DOT_SUBPX);
+        }
+    }
+}
+
+/**
+ * Replace the image's source with a shifted copy of sprite and position it by
+ * its top-left corner, so GForce_Dot_Frame controls where the centre lands.
+ * @param img    the dot lv_img (ui_dot)
+ * @param sprite TRUE_COLOR_ALPHA image of at most DOT_MAX_W x DOT_MAX_H
+ */
+void GForce_Dot_Init(lv_obj_t *img, const lv_img_dsc_t *sprite)
+{
+    if (!img || sprite->header.cf != LV_IMG_CF_TRUE_COLOR_ALPHA ||
+        sprite->header.w > DOT_MAX_W || sprite->header.h > DOT_MAX_H) {
+        printf("GForce dot: unsupported sprite\r\n");
+        return;
+    }
+    dot_img = img;
+    dot_sprite = sprite;
+
+    memset(&dot_dsc, 0, sizeof(dot_dsc));
+    dot_dsc.header.always_zero = 0;
+    dot_dsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    dot_dsc.header.w = sprite->header.w + 1;
+    dot_dsc.header.h = sprite->header.h + 1;
+    dot_dsc.data_size = dot_dsc.header.w * dot_dsc.header.h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    dot_dsc.data = dot_buf;
+    GForce_Dot_Shift(0, 0);
+
+    lv_obj_set_align(dot_img, LV_ALIGN_TOP_LEFT);
+    lv_img_set_src(dot_img, &dot_dsc);
+}
+
+/**
+ * Record a new target position. Consecutive samples give the velocity used to
+ * extrapolate to the time the frame is actually on the glass.
+ */
+void GForce_Dot_Sample(int32_t x_q4, int32_t y_q4, uint32_t t_us)
+{
+    prev_x = last_x;
+    prev_y = last_y;
+    prev_t = last_t;
+    last_x = x_q4;
+    last_y = y_q4;
+    last_t = t_us;
+    if (samples < 2) samples++;
+}
+
+/**
+ * Place the dot where the signal is predicted to be at present_us, by linear
+ * extrapolation from the last two samples. The prediction horizon is limited
+ * to GFORCE_DOT_MAX_EXTRAP_US so a stalled sensor does not fling the dot away.
+ * @param present_us estimated time this frame becomes visible, micros()
+ * @return true if the dot moved and the frame needs rendering
+ */
+bool GForce_Dot_Frame(uint32_t present_us)
+{
+    if (!dot_img || !samples) return false;
+
+    int32_t x = last_x, y = last_y;
+    int32_t dt = (int32_t)(last_t - prev_t);
+    if (samples >= 2 && dt > 0) {
+        int32_t ahead = (int32_t)(present_us - last_t);
+        ahead = constrain(ahead, 0, GFORCE_DOT_MAX_EXTRAP_US);
+        x += (int32_t)((int64_t)(last_x - prev_x) * ahead / dt);
+        y += (int32_t)((int64_t)(last_y - prev_y) * ahead / dt);
+    }
+    if (x == shown_x && y == shown_y) return false;
+
+    // Top-left of the shifted sprite, split into whole pixels and the sub-pixel phase
+    int32_t left = x - (dot_sprite->header.w << GFORCE_DOT_SUBPX_SHIFT) / 2;
+    int32_t top = y - (dot_sprite->header.h << GFORCE_DOT_SUBPX_SHIFT) / 2;
+    uint8_t fx = left & (GFORCE_DOT_SUBPX - 1);
+    uint8_t fy = top & (GFORCE_DOT_SUBPX - 1);
+    if (fx != shown_fx || fy != shown_fy) {
+        GForce_Dot_Shift(fx, fy);
+        lv_obj_invalidate(dot_img);         // same box, new pixels
+        shown_fx = fx;
+        shown_fy = fy;
+    }
+    lv_obj_set_pos(dot_img, left >> GFORCE_DOT_SUBPX_SHIFT, top >> GFORCE_DOT_SUBPX_SHIFT);
+
+    shown_x = x;
+    shown_y = y;
+    return true;
+}
+
+/**
+ * Drop the sample history, so the next sample places the dot without being
+ * extrapolated from samples of an unrelated time base (e.g. a benchmark trace).
+ */
+void GForce_Dot_Reset(void)
+{
+    samples = 0;
+}
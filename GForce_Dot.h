@@ -0,0 +1,20 @@
+#pragma once
+
+#include <lvgl.h>
+
+#define GFORCE_DOT_SUBPX_SHIFT      4           // positions are fixed point, 1/16 px
+#define GFORCE_DOT_SUBPX            (1 << GFORCE_DOT_SUBPX_SHIFT)
+#define GFORCE_DOT_MAX_EXTRAP_US    75000       // never predict further than this past the last sample
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void GForce_Dot_Init(lv_obj_t *img, const lv_img_dsc_t *sprite);   // Take over an lv_img and draw sprite at sub-pixel positions
+void GForce_Dot_Sample(int32_t x_q4, int32_t y_q4, uint32_t t_us);  // New target centre in 1/16 px, with its capture time
+bool GForce_Dot_Frame(uint32_t present_us);                         // Move the dot to its predicted position at present_us
+void GForce_Dot_Reset(void);                                        // Forget the sample history; the dot stays until the next sample
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,82 @@
+#include "GForce_Screen.h"
+#include <Arduino.h>
+#include "LVGL_NumLabel.h"
+#include "Gauge_Face.h"
+#include "GForce_Dot.h"
+#include "Trail_Canvas.h"
+#include "ui.h"
+
+// G readouts, in hundredths of a G
+static NumLabel accel_label, brake_label, left_label, right_label;
+static lv_obj_t *envelope_line = NULL;
+
+/**
+ * Take over the SquareLine widgets of the G-force screen: the procedural face
+ * on ui_bgGauge, the sub-pixel dot, the trail layer between face and dot, the
+ * envelope polygon just below the dot and the cached readouts.
+ * Call once after ui_init(), before the frame scheduler starts.
+ */
+void GForce_Screen_Init(void)
+{
+    Gauge_Face_Init(ui_bgGauge);
+    GForce_Dot_Init(ui_dot, &ui_img_dot_asset_2_png);
+    Trail_Canvas_Init(ui_gforce);
+    if (Trail_Canvas_Obj())
+        lv_obj_move_to_index(Trail_Canvas_Obj(), lv_obj_get_index(ui_bgGauge) + 1);   // between face and dot
+    envelope_line = GG_Envelope_Overlay_Create(ui_gforce);
+    lv_obj_move_to_index(envelope_line, lv_obj_get_index(ui_dot));                  // just below the dot
+    NumLabel_Init(&accel_label, ui_Accel);
+    NumLabel_Init(&brake_label, ui_Brake);
+    NumLabel_Init(&left_label,  ui_Left);
+    NumLabel_Init(&right_label, ui_Right);
+}
+
+/**
+ * Frame update, called by the frame scheduler at frame start only when a new
+ * sample arrived. Runs in the LVGL task with the LVGL lock held.
+ */
+void GForce_Screen_Update(const IMUSample *sample)
+{
+    if (!ui_dot) return;  // make sure UI elements exist
+
+    float x = sample->x;
+    float y = sample->y;
+
+    // Center (240, 240) for 480x480 screen, scaled to the gauge face rings
+    float px_per_g = Gauge_Face_Px_Per_G();
+    float xpos = 240 - (x * px_per_g);
+    float ypos = 240 - (y * px_per_g);
+
+    // Clamp for safety
+    xpos = constrain(xpos, 20, 460);
+    ypos = constrain(ypos, 20, 460);
+
+    // Kept at 1/16 px; the dot itself moves every frame in GForce_Dot_Frame()
+    GForce_Dot_Sample(lroundf(xpos * GFORCE_DOT_SUBPX), lroundf(ypos * GFORCE_DOT_SUBPX), sample->t_us);
+
+    // Trail point coloured green -> red with the share of full scale
+    float share = min(sqrtf(x * x + y * y) / Gauge_Face_Full_Scale(), 1.0f);
+    Trail_Canvas_Add((lv_coord_t)xpos, (lv_coord_t)ypos, lv_color_hsv_to_rgb(120 - (uint16_t)(share * 120), 100, 60));
+
+    // Update G-force readouts (only changed digits are redrawn)
+    int32_t gx = lroundf(x * 100);
+    int32_t gy = lroundf(y * 100);
+    NumLabel_Set(&accel_label, max(gy, (int32_t)0));
+    NumLabel_Set(&brake_label, max(-gy, (int32_t)0));
+    NumLabel_Set(&left_label,  max(-gx, (int32_t)0));
+    NumLabel_Set(&right_label, max(gx, (int32_t)0));
+}
+
+/**
+ * Runs every frame, new sample or not.
+ * @param present_us time the frame becomes visible, micros()
+ * @param shown      envelope drawn by the overlay
+ * @return true if the frame needs rendering
+ */
+bool GForce_Screen_Tick(uint32_t present_us, const GGEnvelope *shown)
+{
+    bool dot = GForce_Dot_Frame(present_us);
+    bool trail = Trail_Canvas_Fade();
+    bool envelope = GG_Envelope_Overlay_Update(envelope_line, shown, Gauge_Face_Px_Per_G());
+    return dot || trail || envelope;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <lvgl.h>
+#include "IMU_Sample.h"
+#include "GG_Envelope.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void GForce_Screen_Init(void);                                      // After ui_init(): face, dot, trail, envelope overlay, readouts
+void GForce_Screen_Update(const IMUSample *sample);                 // New sample: dot target, trail point, readouts
+bool GForce_Screen_Tick(uint32_t present_us, const GGEnvelope *shown); // Every frame: dot motion, trail fade, envelope overlay
+
+#ifdef __cplusplus
+}
+#endif
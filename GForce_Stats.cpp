@@ -0,0 +1,241 @@
+#include "GForce_Stats.h"
+#include <esp_heap_caps.h>
+
+// One second of the rolling window
+typedef struct GStatsBucket {
+    GStatAcc acc[GSTATS_CHANNELS];
+    uint16_t hist[GSTATS_CHANNELS][GSTATS_BINS];
+} GStatsBucket;
+
+typedef struct GStatsWindow {
+    GStatAcc acc[GSTATS_CHANNELS];
+    uint32_t hist[GSTATS_CHANNELS][GSTATS_BINS];
+} GStatsWindow;
+
+// GStats.lock is a mutex, not a spinlock: retiring a bucket and summarising a scope walk whole
+// histograms in PSRAM, far too long to run with interrupts off on the sensor core
+
+static void Stat_Acc_Reset(GStatAcc *a)
+{
+    a->n = 0;
+    a->mean = 0.0;
+    a->m2 = 0.0;
+    a->min = INFINITY;
+    a->max = -INFINITY;
+}
+
+static inline void Stat_Acc_Add(GStatAcc *a, float v)
+{
+    a->n++;
+    double d = v - a->mean;
+    a->mean += d / a->n;
+    a->m2 += d * (v - a->mean);
+    if (v < a->min) a->min = v;
+    if (v > a->max) a->max = v;
+}
+
+// Combine two accumulators (Chan et al. parallel variance)
+static void Stat_Acc_Merge(GStatAcc *a, const GStatAcc *b)
+{
+    if (!b->n) return;
+    if (!a->n) {
+        *a = *b;
+        return;
+    }
+    uint32_t n = a->n + b->n;
+    double d = b->mean - a->mean;
+    a->m2 += b->m2 + d * d * ((double)a->n * b->n / n);
+    a->mean += d * b->n / n;
+    a->n = n;
+    a->min = min(a->min, b->min);
+    a->max = max(a->max, b->max);
+}
+
+static inline uint16_t Stat_Bin(float v)
+{
+    int32_t b = (int32_t)floorf(v / GSTATS_BIN_G) + GSTATS_BINS / 2;
+    return (uint16_t)constrain(b, 0, GSTATS_BINS - 1);
+}
+
+static void Stats_Clear_Bucket(GStatsBucket *b)
+{
+    for (uint8_t c = 0; c < GSTATS_CHANNELS; c++) Stat_Acc_Reset(&b->acc[c]);
+    memset(b->hist, 0, sizeof(b->hist));
+}
+
+static void Stats_Clear_Window(GStatsWindow *w)
+{
+    for (uint8_t c = 0; c < GSTATS_CHANNELS; c++) Stat_Acc_Reset(&w->acc[c]);
+    memset(w->hist, 0, sizeof(w->hist));
+}
+
+/**
+ * Move the rolling window forward to the second sec, retiring every bucket
+ * that falls out of it from the rolling histogram.
+ */
+static void Stats_Advance(GStats *st, uint32_t sec)
+{
+    uint32_t steps = min(sec - st->bucket_sec, (uint32_t)GSTATS_WINDOW_S);
+    GStatsWindow *roll = &st->windows[GSTATS_ROLLING];
+    for (uint32_t i = 0; i < steps; i++) {
+        st->bucket_idx = (st->bucket_idx + 1) % GSTATS_WINDOW_S;
+        GStatsBucket *b = &st->buckets[st->bucket_idx];
+        for (uint8_t c = 0; c < GSTATS_CHANNELS; c++)
+            for (uint16_t k = 0; k < GSTATS_BINS; k++)
+                roll->hist[c][k] -= b->hist[c][k];
+        Stats_Clear_Bucket(b);
+    }
+    st->bucket_sec = sec;
+}
+
+/**
+ * Allocate the fixed statistics budget of one set of scopes (about 40 KB of PSRAM).
+ */
+bool GForce_Stats_Init(GStats *st)
+{
+    st->lock = xSemaphoreCreateMutex();
+    st->buckets = (GStatsBucket *)heap_caps_malloc(GSTATS_WINDOW_S * sizeof(GStatsBucket), MALLOC_CAP_SPIRAM);
+    st->windows = (GStatsWindow *)heap_caps_malloc(GSTATS_SCOPES * sizeof(GStatsWindow), MALLOC_CAP_SPIRAM);
+    if (!st->lock || !st->buckets || !st->windows) {
+        printf("GForce stats: out of memory\r\n");
+        if (st->lock) vSemaphoreDelete(st->lock);
+        heap_caps_free(st->buckets);
+        heap_caps_free(st->windows);
+        st->lock = NULL;
+        st->buckets = NULL;
+        st->windows = NULL;
+        return false;
+    }
+    GForce_Stats_Reset(st);
+    return true;
+}
+
+/**
+ * Fold one sample into every scope. O(1) apart from retiring a bucket once a
+ * second. Safe to call from the sensor task while the UI queries; not from an ISR.
+ * @param t_ms sample time in ms on the source's own clock (sample clock or log time), so a
+ *             replay at any speed or in single steps fills the rolling window by log seconds
+ */
+void GForce_Stats_Add(GStats *st, float lat_g, float long_g, uint32_t t_ms)
+{
+    if (!st->buckets) return;
+    float v[GSTATS_CHANNELS];
+    v[GSTATS_LONG] = long_g;
+    v[GSTATS_LAT] = lat_g;
+    v[GSTATS_COMBINED] = sqrtf(lat_g * lat_g + long_g * long_g);
+
+    xSemaphoreTake(st->lock, portMAX_DELAY);
+    uint32_t sec = t_ms / 1000;
+    if (st->bucket_sec == GSTATS_NO_SEC) st->bucket_sec = sec;     // first sample sets the clock
+    else if (sec != st->bucket_sec) Stats_Advance(st, sec);
+    GStatsBucket *b = &st->buckets[st->bucket_idx];
+    for (uint8_t c = 0; c < GSTATS_CHANNELS; c++) {
+        uint16_t bin = Stat_Bin(v[c]);
+        Stat_Acc_Add(&b->acc[c], v[c]);
+        b->hist[c][bin]++;
+        st->windows[GSTATS_ROLLING].hist[c][bin]++;
+        for (uint8_t s = GSTATS_LAP; s < GSTATS_SCOPES; s++) {
+            Stat_Acc_Add(&st->windows[s].acc[c], v[c]);
+            st->windows[s].hist[c][bin]++;
+        }
+    }
+    xSemaphoreGive(st->lock);
+}
+
+void GForce_Stats_New_Lap(GStats *st)
+{
+    if (!st->windows) return;
+    xSemaphoreTake(st->lock, portMAX_DELAY);
+    Stats_Clear_Window(&st->windows[GSTATS_LAP]);
+    xSemaphoreGive(st->lock);
+}
+
+/**
+ * Start a new session: clears every scope, including the rolling window.
+ */
+void GForce_Stats_Reset(GStats *st)
+{
+    if (!st->windows) return;
+    xSemaphoreTake(st->lock, portMAX_DELAY);
+    for (uint8_t i = 0; i < GSTATS_WINDOW_S; i++) Stats_Clear_Bucket(&st->buckets[i]);
+    for (uint8_t s = 0; s < GSTATS_SCOPES; s++) Stats_Clear_Window(&st->windows[s]);
+    st->bucket_sec = GSTATS_NO_SEC;
+    st->bucket_idx = 0;
+    xSemaphoreGive(st->lock);
+}
+
+// Centre of the bin holding the given percentile
+static float Stat_Percentile(const uint32_t *hist, uint32_t n, uint8_t pct)
+{
+    uint32_t target = (n * pct + 99) / 100;
+    uint32_t sum = 0;
+    for (uint16_t k = 0; k < GSTATS_BINS; k++) {
+        sum += hist[k];
+        if (sum >= target) return ((int32_t)k - GSTATS_BINS / 2 + 0.5f) * GSTATS_BIN_G;
+    }
+    return (GSTATS_BINS / 2) * GSTATS_BIN_G;
+}
+
+/**
+ * Summarise one channel of one scope.
+ * @return false if the scope has no samples
+ */
+bool GForce_Stats_Get(GStats *st, GStatsScope scope, GStatsChannel ch, GStatSummary *out)
+{
+    memset(out, 0, sizeof(*out));
+    if (!st->windows) return false;
+
+    GStatAcc acc;
+    xSemaphoreTake(st->lock, portMAX_DELAY);
+    if (scope == GSTATS_ROLLING) {
+        Stat_Acc_Reset(&acc);
+        for (uint8_t i = 0; i < GSTATS_WINDOW_S; i++) Stat_Acc_Merge(&acc, &st->buckets[i].acc[ch]);
+    } else {
+        acc = st->windows[scope].acc[ch];
+    }
+    if (acc.n) {
+        const uint32_t *hist = st->windows[scope].hist[ch];
+        out->p50 = Stat_Percentile(hist, acc.n, 50);
+        out->p95 = Stat_Percentile(hist, acc.n, 95);
+        out->p99 = Stat_Percentile(hist, acc.n, 99);
+    }
+    xSemaphoreGive(st->lock);
+
+    if (!acc.n) return false;
+    double var = acc.m2 / acc.n;
+    out->n = acc.n;
+    out->min = acc.min;
+    out->max = acc.max;
+    out->mean = (float)acc.mean;
+    out->stddev = (float)sqrt(var);
+    out->rms = (float)sqrt(var + acc.mean * acc.mean);
+    return true;
+}
+
+/**
+ * One text line per channel for a scope, e.g. for Serial or a log summary.
+ * @return characters written, as snprintf
+ */
+int GForce_Stats_Format(GStats *st, char *buf, size_t len, GStatsScope scope)
+{
+    static const char *scopes[GSTATS_SCOPES] = {"rolling", "lap", "session"};
+    static const char *channels[GSTATS_CHANNELS] = {"long", "lat", "comb"};
+    int used = snprintf(buf, len, "%s:\r\n", scopes[scope]);
+    for (uint8_t c = 0; c < GSTATS_CHANNELS && used >= 0 && (size_t)used < len; c++) {
+        GStatSummary s;
+        if (!GForce_Stats_Get(st, scope, (GStatsChannel)c, &s)) continue;
+        used += snprintf(buf + used, len - used,
+                         "  %-4s n %lu min %+.2f max %+.2f mean %+.2f rms %.2f sd %.2f p50 %+.2f p95 %+.2f p99 %+.2f\r\n",
+                         channels[c], (unsigned long)s.n, s.min, s.max, s.mean, s.rms, s.stddev, s.p50, s.p95, s.p99);
+    }
+    return used;
+}
+
+void GForce_Stats_Print(GStats *st)
+{
+    static char buf[512];
+    for (uint8_t s = 0; s < GSTATS_SCOPES; s++) {
+        GForce_Stats_Format(st, buf, sizeof(buf), (GStatsScope)s);
+        printf("%s", buf);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <Arduino.h>
+
+#define GSTATS_BIN_G        0.02f   // histogram resolution for percentiles
+#define GSTATS_BINS         400     // covers -4..+4 G, outliers go to the end bins
+#define GSTATS_WINDOW_S     10      // rolling window, kept as 1 s buckets
+#define GSTATS_NO_SEC       UINT32_MAX  // bucket_sec before the first sample
+
+typedef enum {
+    GSTATS_LONG = 0,        // longitudinal: + accelerating, - braking
+    GSTATS_LAT,             // lateral: + right, - left
+    GSTATS_COMBINED,        // magnitude of both
+    GSTATS_CHANNELS
+} GStatsChannel;
+
+typedef enum {
+    GSTATS_ROLLING = 0,     // last GSTATS_WINDOW_S seconds
+    GSTATS_LAP,
+    GSTATS_SESSION,
+    GSTATS_SCOPES
+} GStatsScope;
+
+// Running moments (Welford) plus extremes. The moments are double: a session runs to millions of
+// samples, and in float the increments d / n vanish against the mean long before that.
+typedef struct {
+    uint32_t n;
+    double mean;
+    double m2;              // sum of squared deviations from the mean
+    float min;
+    float max;
+} GStatAcc;
+
+typedef struct {
+    uint32_t n;
+    float min, max, mean, rms, stddev;
+    float p50, p95, p99;
+} GStatSummary;
+
+struct GStatsBucket;
+struct GStatsWindow;
+
+// One set of scopes for one sample source, e.g. the live session or a replay; about 40 KB of PSRAM
+typedef struct {
+    struct GStatsBucket *buckets;   // ring of GSTATS_WINDOW_S
+    struct GStatsWindow *windows;   // [GSTATS_SCOPES]; ROLLING only uses hist, acc comes from the buckets
+    uint32_t bucket_sec;            // second of the current bucket on the samples' clock
+    uint8_t bucket_idx;
+    SemaphoreHandle_t lock;
+} GStats;
+
+bool GForce_Stats_Init(GStats *st);
+void GForce_Stats_Add(GStats *st, float lat_g, float long_g, uint32_t t_ms);
+void GForce_Stats_New_Lap(GStats *st);
+void GForce_Stats_Reset(GStats *st);
+bool GForce_Stats_Get(GStats *st, GStatsScope scope, GStatsChannel ch, GStatSummary *out);
+int GForce_Stats_Format(GStats *st, char *buf, size_t len, GStatsScope scope);
+void GForce_Stats_Print(GStats *st);
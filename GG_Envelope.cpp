@@ -0,0 +1,125 @@
+#include "GG_Envelope.h"
+#include <Arduino.h>
+#include <string.h>
+
+#define GG_CENTER       240     // overlay centre on the 480x480 panel
+#define GG_OVERLAY_MS   200     // while bins keep growing, the outline is rebuilt at most this often
+
+static lv_point_t overlay_pts[GG_ENVELOPE_BINS + 1];   // one per seen bin, plus the closing point
+static uint32_t overlay_changes = UINT32_MAX;
+static const GGEnvelope *overlay_env = NULL;      // the envelope drawn last, the UI may switch between several
+static float overlay_px_per_g = 0.0f;
+static uint32_t overlay_ms = 0;                  // time of the last rebuild
+
+void GG_Envelope_Reset(GGEnvelope *env)
+{
+    memset(env->max_mg, 0, sizeof(env->max_mg));
+    env->changes++;
+}
+
+/**
+ * Direction of (x, y) as a bin index without atan2f: fold into the first
+ * octant and use atan(z) ~ z * (pi/4 + 0.273 * (1 - z)), good to 0.22 degrees.
+ */
+uint16_t IRAM_ATTR GG_Envelope_Bin(float x, float y)
+{
+    float ax = fabsf(x), ay = fabsf(y);
+    if (ax == 0.0f && ay == 0.0f) return 0;
+
+    bool steep = ay > ax;
+    float z = steep ? ax / ay : ay / ax;
+    float deg = z * (45.0f + 15.64f * (1.0f - z));     // 0..45
+    if (steep) deg = 90.0f - deg;
+    if (x < 0.0f) deg = 180.0f - deg;
+    if (y < 0.0f) deg = 360.0f - deg;
+
+    uint16_t bin = (uint16_t)(deg * (GG_ENVELOPE_BINS / 360.0f) + 0.5f);
+    return bin < GG_ENVELOPE_BINS ? bin : 0;
+}
+
+/**
+ * Fold one sample into the envelope: a bin lookup and a compare.
+ * Bins are 16-bit stores, so the UI can read them while the sensor task writes.
+ */
+void IRAM_ATTR GG_Envelope_Add(GGEnvelope *env, float x_g, float y_g)
+{
+    float mag = sqrtf(x_g * x_g + y_g * y_g) * 1000.0f;
+    uint16_t mg = mag < 65535.0f ? (uint16_t)mag : 65535;
+    uint16_t bin = GG_Envelope_Bin(x_g, y_g);
+    if (mg > env->max_mg[bin]) {
+        env->max_mg[bin] = mg;
+        env->changes++;
+    }
+}
+
+/**
+ * Create the envelope outline: a closed lv_line that does not take input.
+ * It is resized to the polygon on every rebuild.
+ */
+lv_obj_t *GG_Envelope_Overlay_Create(lv_obj_t *parent)
+{
+    lv_obj_t *line = lv_line_create(parent);
+    lv_obj_set_pos(line, GG_CENTER, GG_CENTER);
+    lv_obj_set_size(line, 0, 0);
+    lv_obj_clear_flag(line, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_style_line_color(line, lv_color_hex(0x00C8FF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_line_width(line, 2, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_line_rounded(line, true, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_line_opa(line, LV_OPA_70, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_line_set_points(line, overlay_pts, 0);
+    return line;
+}
+
+/**
+ * Rebuild the outline from the seen bins if the envelope or the scale changed
+ * since the last call. Growing bins are picked up at most every GG_OVERLAY_MS;
+ * another envelope or scale is drawn at once. The line object is fitted to the
+ * polygon's bounding box, so a rebuild invalidates only the old and new box.
+ * Uses the same screen mapping as the dot: +x G to the left, +y G up.
+ * @return true if the outline changed
+ */
+bool GG_Envelope_Overlay_Update(lv_obj_t *line, const GGEnvelope *env, float px_per_g)
+{
+    uint32_t changes = env->changes;
+    if (!line || (env == overlay_env && changes == overlay_changes && px_per_g == overlay_px_per_g)) return false;
+    uint32_t now = millis();
+    if (env == overlay_env && px_per_g == overlay_px_per_g && now - overlay_ms < GG_OVERLAY_MS) return false;
+    overlay_env = env;
+    overlay_changes = changes;
+    overlay_px_per_g = px_per_g;
+    overlay_ms = now;
+
+    uint16_t n = 0;
+    float scale = px_per_g / 1000.0f;
+    lv_area_t box = {GG_CENTER, GG_CENTER, GG_CENTER - 1, GG_CENTER - 1};
+    for (uint16_t b = 0; b < GG_ENVELOPE_BINS; b++) {
+        uint16_t mg = env->max_mg[b];
+        if (!mg) continue;
+        float a = b * (2.0f * PI / GG_ENVELOPE_BINS);
+        float r = min(mg * scale, (float)GG_CENTER);
+        lv_point_t *p = &overlay_pts[n];
+        p->x = GG_CENTER - (lv_coord_t)lroundf(r * cosf(a));
+        p->y = GG_CENTER - (lv_coord_t)lroundf(r * sinf(a));
+        if (n == 0) {
+            box.x1 = box.x2 = p->x;
+            box.y1 = box.y2 = p->y;
+        } else {
+            box.x1 = min(box.x1, p->x);
+            box.y1 = min(box.y1, p->y);
+            box.x2 = max(box.x2, p->x);
+            box.y2 = max(box.y2, p->y);
+        }
+        n++;
+    }
+
+    // Points relative to the box, which becomes the line's area
+    for (uint16_t i = 0; i < n; i++) {
+        overlay_pts[i].x -= box.x1;
+        overlay_pts[i].y -= box.y1;
+    }
+    if (n > 1) overlay_pts[n++] = overlay_pts[0];
+    lv_obj_set_pos(line, box.x1, box.y1);
+    lv_obj_set_size(line, box.x2 - box.x1 + 1, box.y2 - box.y1 + 1);
+    lv_line_set_points(line, overlay_pts, n);
+    return true;
+}
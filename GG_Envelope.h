@@ -0,0 +1,26 @@
+#pragma once
+
+#include <lvgl.h>
+
+#define GG_ENVELOPE_BINS    360     // 1 degree per bin
+
+// Friction circle: the largest combined G seen in every direction
+typedef struct {
+    uint16_t max_mg[GG_ENVELOPE_BINS];  // per-bin maximum in milli-g, 0 = direction not seen yet
+    volatile uint32_t changes;          // bumped whenever a bin grows
+} GGEnvelope;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void GG_Envelope_Reset(GGEnvelope *env);
+void GG_Envelope_Add(GGEnvelope *env, float x_g, float y_g);        // O(1), no allocation, safe from the sensor task
+uint16_t GG_Envelope_Bin(float x, float y);                        // Direction bin, 0 = +x, counter-clockwise
+
+lv_obj_t *GG_Envelope_Overlay_Create(lv_obj_t *parent);            // lv_line polygon overlay
+bool GG_Envelope_Overlay_Update(lv_obj_t *line, const GGEnvelope *env, float px_per_g);
+
+#ifdef __cplusplus
+}
+#endif
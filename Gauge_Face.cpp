@@ -0,0 +1,156 @@
+#include "Gauge_Face.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+#define GAUGE_HALF          (GAUGE_SIZE / 2)
+#define GAUGE_TICK_LEN      12
+#define GAUGE_COLOR_BG      0x000000
+#define GAUGE_COLOR_AXIS    0x303030
+#define GAUGE_COLOR_RING    0x606060
+#define GAUGE_COLOR_LIMIT   0xC0C0C0
+#define GAUGE_COLOR_TEXT    0x909090
+
+static lv_obj_t *face_canvas = NULL;
+static lv_color_t *face_buf = NULL;
+static float face_full_scale = GAUGE_FULL_SCALE_G;
+static float face_step = GAUGE_STEP_G;
+static uint32_t face_render_us = 0;
+
+/**
+ * Blend one pixel into each quadrant. qx, qy are offsets from the centre,
+ * which lies between pixels GAUGE_HALF - 1 and GAUGE_HALF.
+ */
+static inline void Gauge_Face_Plot4(int qx, int qy, lv_color_t color, lv_opa_t opa)
+{
+    int xs[2] = {GAUGE_HALF + qx, GAUGE_HALF - 1 - qx};
+    int ys[2] = {GAUGE_HALF + qy, GAUGE_HALF - 1 - qy};
+    for (int j = 0; j < 2; j++) {
+        lv_color_t *row = face_buf + ys[j] * GAUGE_SIZE;
+        for (int i = 0; i < 2; i++)
+            row[xs[i]] = opa >= LV_OPA_MAX ? color : lv_color_mix(color, row[xs[i]], opa);
+    }
+}
+
+/**
+ * Anti-aliased ring. Only the pixels of the annulus are visited, one
+ * quadrant computed and mirrored.
+ * @param r      radius to the middle of the stroke, px
+ * @param half_w half the stroke width, px
+ */
+static void Gauge_Face_Ring(float r, float half_w, lv_color_t color)
+{
+    float outer = r + half_w + 1.0f;
+    float inner = r - half_w - 1.0f;
+    for (int qy = 0; qy < GAUGE_HALF && qy + 0.5f < outer; qy++) {
+        float fy = qy + 0.5f;
+        int x0 = inner > fy ? (int)sqrtf(inner * inner - fy * fy) - 1 : 0;
+        int x1 = min(GAUGE_HALF - 1, (int)sqrtf(outer * outer - fy * fy));
+        for (int qx = max(x0, 0); qx <= x1; qx++) {
+            float fx = qx + 0.5f;
+            float cov = half_w + 0.5f - fabsf(sqrtf(fx * fx + fy * fy) - r);
+            if (cov <= 0.0f) continue;
+            Gauge_Face_Plot4(qx, qy, color, cov >= 1.0f ? LV_OPA_COVER : (lv_opa_t)(cov * 255));
+        }
+    }
+}
+
+static void Gauge_Face_Fill(int x, int y, int w, int h, lv_color_t color)
+{
+    for (int row = max(y, 0); row < min(y + h, GAUGE_SIZE); row++)
+        for (int col = max(x, 0); col < min(x + w, GAUGE_SIZE); col++)
+            face_buf[row * GAUGE_SIZE + col] = color;
+}
+
+/**
+ * Rasterize the whole face for the current scale: axes, a ring and ticks
+ * every step, a brighter ring at full scale and the G value of each ring.
+ */
+static void Gauge_Face_Render(void)
+{
+    lv_color_t axis = lv_color_hex(GAUGE_COLOR_AXIS);
+    lv_color_t ring = lv_color_hex(GAUGE_COLOR_RING);
+    lv_color_t limit = lv_color_hex(GAUGE_COLOR_LIMIT);
+    float px_per_g = Gauge_Face_Px_Per_G();
+    int rings = (int)lroundf(face_full_scale / face_step);
+
+    lv_color_t bg = lv_color_hex(GAUGE_COLOR_BG);
+    for (uint32_t i = 0; i < GAUGE_SIZE * GAUGE_SIZE; i++) face_buf[i] = bg;
+
+    Gauge_Face_Fill(GAUGE_HALF - 1, 0, 2, GAUGE_SIZE, axis);
+    Gauge_Face_Fill(0, GAUGE_HALF - 1, GAUGE_SIZE, 2, axis);
+
+    lv_draw_label_dsc_t text;
+    lv_draw_label_dsc_init(&text);
+    text.color = lv_color_hex(GAUGE_COLOR_TEXT);
+    text.font = LV_FONT_DEFAULT;
+    lv_coord_t text_h = lv_font_get_line_height(text.font);
+
+    for (int i = 1; i <= rings; i++) {
+        int r = (int)lroundf(i * face_step * px_per_g);
+        bool last = (i == rings);
+        Gauge_Face_Ring(r, last ? 1.5f : 0.75f, last ? limit : ring);
+
+        Gauge_Face_Fill(GAUGE_HALF - r - 1, GAUGE_HALF - GAUGE_TICK_LEN / 2, 2, GAUGE_TICK_LEN, ring);
+        Gauge_Face_Fill(GAUGE_HALF + r - 1, GAUGE_HALF - GAUGE_TICK_LEN / 2, 2, GAUGE_TICK_LEN, ring);
+        Gauge_Face_Fill(GAUGE_HALF - GAUGE_TICK_LEN / 2, GAUGE_HALF - r - 1, GAUGE_TICK_LEN, 2, ring);
+        Gauge_Face_Fill(GAUGE_HALF - GAUGE_TICK_LEN / 2, GAUGE_HALF + r - 1, GAUGE_TICK_LEN, 2, ring);
+
+        char buf[8];
+        snprintf(buf, sizeof(buf), "%.1f", i * face_step);
+        lv_canvas_draw_text(face_canvas, GAUGE_HALF + 4, GAUGE_HALF - r - text_h - 2, 40, &text, buf);
+        lv_canvas_draw_text(face_canvas, GAUGE_HALF + r + 4, GAUGE_HALF + 2, 40, &text, buf);
+    }
+}
+
+/**
+ * Give the canvas an RGB565 buffer in PSRAM sized to the panel and draw the
+ * default scale.
+ * @param canvas an lv_canvas (ui_bgGauge)
+ */
+void Gauge_Face_Init(lv_obj_t *canvas)
+{
+    face_buf = (lv_color_t *)heap_caps_malloc(GAUGE_SIZE * GAUGE_SIZE * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+    if (!face_buf) {
+        printf("Gauge face: out of PSRAM\r\n");
+        return;
+    }
+    face_canvas = canvas;
+    lv_canvas_set_buffer(face_canvas, face_buf, GAUGE_SIZE, GAUGE_SIZE, LV_IMG_CF_TRUE_COLOR);
+    Gauge_Face_Set_Scale(GAUGE_FULL_SCALE_G, GAUGE_STEP_G);
+}
+
+/**
+ * Re-rasterize the face for a new scale. Call with the LVGL lock held once
+ * LVGL runs in its own task.
+ * @param full_scale_g G at the outer ring
+ * @param step_g       G between rings
+ */
+void Gauge_Face_Set_Scale(float full_scale_g, float step_g)
+{
+    if (!face_buf || full_scale_g <= 0.0f || step_g <= 0.0f) return;
+
+    face_full_scale = full_scale_g;
+    face_step = step_g;
+    uint32_t start = micros();
+    Gauge_Face_Render();
+    face_render_us = micros() - start;
+    lv_obj_invalidate(face_canvas);
+
+    printf("Gauge face: %.2f G full scale, %.2f G steps, rasterized in %lu us\r\n",
+           face_full_scale, face_step, (unsigned long)face_render_us);
+}
+
+float Gauge_Face_Full_Scale(void)
+{
+    return face_full_scale;
+}
+
+float Gauge_Face_Px_Per_G(void)
+{
+    return GAUGE_RADIUS_PX / face_full_scale;
+}
+
+uint32_t Gauge_Face_Render_Us(void)
+{
+    return face_render_us;
+}
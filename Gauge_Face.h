@@ -0,0 +1,22 @@
+#pragma once
+
+#include <lvgl.h>
+
+#define GAUGE_SIZE              480     // canvas edge in px, matches the panel
+#define GAUGE_RADIUS_PX         220     // radius of the full-scale ring
+#define GAUGE_FULL_SCALE_G      1.5f    // default G at the outer ring
+#define GAUGE_STEP_G            0.5f    // default G between rings
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void Gauge_Face_Init(lv_obj_t *canvas);                      // Allocate the face in PSRAM and draw the default scale
+void Gauge_Face_Set_Scale(float full_scale_g, float step_g); // Re-rasterize for a new scale
+float Gauge_Face_Full_Scale(void);
+float Gauge_Face_Px_Per_G(void);
+uint32_t Gauge_Face_Render_Us(void);                        // Duration of the last rasterization
+
+#ifdef __cplusplus
+}
+#endif
@@ -81,22 +81,34 @@ void QMI8658_transmit(uint8_t addr, uint8_t data)
  */
 uint8_t QMI8658_receive(uint8_t addr)
 {
-    uint8_t retval;
+    uint8_t retval = 0;
     I2C_Read(Device_addr, addr, &retval, 1);
     return retval;
 }
 
 /**
- * Writes data to CTRL9 (command register) and waits for ACK.
+ * Writes data to CTRL9 (command register), waits for the sensor to report it done
+ * and acknowledges it. Gives up after QMI8658_COMM_TIMEOUT, e.g. on a bus fault.
  * @param command the command to be executed
+ * @return false if the command did not complete in time
  */
-void QMI8658_CTRL9_Write(uint8_t command)
+bool QMI8658_CTRL9_Write(uint8_t command)
 {
     // transmit command
     QMI8658_transmit(QMI8658_CTRL9, command);
 
     // wait for command to be done
-    while (((QMI8658_receive(QMI8658_STATUSINT)) & 0x80) == 0x00);
+    uint32_t start = millis();
+    while (((QMI8658_receive(QMI8658_STATUSINT)) & 0x80) == 0x00) {
+        if (millis() - start > QMI8658_COMM_TIMEOUT) {
+            printf("QMI8658: command 0x%02x timed out\r\n", command);
+            return false;
+        }
+    }
+
+    // acknowledge, which clears CmdDone for the next command
+    QMI8658_transmit(QMI8658_CTRL9, QMI8658_CTRL_CMD_ACK);
+    return true;
 }
 
 /**
@@ -286,6 +298,86 @@ void getGyroscope(void)
     Gyro.z = Gyro.z * gyroScales;
 }
 
+/**
+ * Switch to full-rate acquisition through the FIFO: accelerometer only (the
+ * gyro is not used and would double the bus traffic), stream mode, 128 deep.
+ * @param odr accelerometer data rate; without the gyro the nominal rates apply
+ */
+void QMI8658_FIFO_Init(acc_odr_t odr)
+{
+    // high speed internal clock, accelerometer only
+    QMI8658_transmit(QMI8658_CTRL7, 0x41);
+    setAccODR(odr);
+
+    QMI8658_transmit(QMI8658_FIFO_WTM_TH, 64);
+    QMI8658_transmit(QMI8658_FIFO_CTRL, QMI8658_FIFO_SIZE_128 | QMI8658_FIFO_MODE_STREAM);
+    QMI8658_CTRL9_Write(QMI8658_CTRL_CMD_RST_FIFO);
+    printf("QMI8658 FIFO: %.0f Hz accelerometer stream\r\n", QMI8658_Acc_ODR_Hz());
+}
+
+/**
+ * Drain up to max samples from the FIFO, oldest first, and update Accel
+ * with the newest one.
+ * @param raw receives x, y, z in LSB (see QMI8658_Acc_LSB_G)
+ * @return number of samples read, 0 if the sensor did not answer
+ */
+uint16_t QMI8658_FIFO_Read(int16_t (*raw)[3], uint16_t max)
+{
+    uint8_t cnt[2];
+    if (!I2C_Read(Device_addr, QMI8658_FIFO_SMPL_CNT, cnt, 2)) return 0;
+    uint16_t bytes = (((cnt[1] & 0x03) << 8) | cnt[0]) * 2;
+    uint16_t frames = bytes / QMI8658_FIFO_FRAME;
+    if (frames > max) frames = max;
+    if (!frames) return 0;
+
+    if (!QMI8658_CTRL9_Write(QMI8658_CTRL_CMD_REQ_FIFO)) {
+        QMI8658_transmit(QMI8658_FIFO_CTRL, QMI8658_FIFO_SIZE_128 | QMI8658_FIFO_MODE_STREAM);
+        return 0;
+    }
+    uint8_t buf[QMI8658_FIFO_CHUNK * QMI8658_FIFO_FRAME];
+    uint16_t done = 0;
+    while (done < frames) {
+        uint16_t n = frames - done;
+        if (n > QMI8658_FIFO_CHUNK) n = QMI8658_FIFO_CHUNK;
+        if (!I2C_Read(Device_addr, QMI8658_FIFO_DATA, buf, n * QMI8658_FIFO_FRAME)) break;
+        for (uint16_t i = 0; i < n; i++) {
+            const uint8_t *p = buf + i * QMI8658_FIFO_FRAME;
+            raw[done + i][0] = (int16_t)((p[1] << 8) | p[0]);
+            raw[done + i][1] = (int16_t)((p[3] << 8) | p[2]);
+            raw[done + i][2] = (int16_t)((p[5] << 8) | p[4]);
+        }
+        done += n;
+    }
+    // leave FIFO read mode
+    QMI8658_transmit(QMI8658_FIFO_CTRL, QMI8658_FIFO_SIZE_128 | QMI8658_FIFO_MODE_STREAM);
+
+    if (done) {
+        Accel.x = raw[done - 1][0] * accelScales;
+        Accel.y = raw[done - 1][1] * accelScales;
+        Accel.z = raw[done - 1][2] * accelScales;
+    }
+    return done;
+}
+
+/**
+ * Accelerometer resolution in G per LSB for the configured range.
+ */
+float QMI8658_Acc_LSB_G(void)
+{
+    return accelScales;
+}
+
+/**
+ * Nominal accelerometer data rate in Hz (accelerometer-only mode).
+ */
+float QMI8658_Acc_ODR_Hz(void)
+{
+    static const float odr_hz[] = {8000, 4000, 2000, 1000, 500, 250, 125, 62.5f, 31.25f};
+    if (acc_odr < sizeof(odr_hz) / sizeof(odr_hz[0])) return odr_hz[acc_odr];
+    return 0.0f;
+}
+
+
 
 
 
@@ -30,6 +30,12 @@
 #define QMI8658_TEMP_L 0x33 // lower bits of temperature data
 #define QMI8658_TEMP_H 0x34 // upper bits of temperature data
 
+#define QMI8658_FIFO_WTM_TH   0x13 // FIFO watermark, in samples
+#define QMI8658_FIFO_CTRL     0x14 // FIFO size and mode
+#define QMI8658_FIFO_SMPL_CNT 0x15 // FIFO fill level, lower bits, in 2-byte words
+#define QMI8658_FIFO_STATUS   0x16 // FIFO flags + fill level upper bits
+#define QMI8658_FIFO_DATA     0x17 // FIFO read port
+
 #define QMI8658_STATUSINT 0x2D // status + interrupt register
 
 #define QMI8658_AX_L 0x35 // lower bits of x-axis acceleration
@@ -65,7 +71,15 @@
 #define QMI8658_REFRESH_DELAY 2000
 
 // control clock gating (necessary to use data locking)
+#define QMI8658_CTRL_CMD_ACK 0x00 // host acknowledges a finished command, clears STATUSINT.CmdDone
 #define QMI8658_CTRL_CMD_AHB_CLOCK_GATING 0x12
+#define QMI8658_CTRL_CMD_RST_FIFO 0x04
+#define QMI8658_CTRL_CMD_REQ_FIFO 0x05
+
+#define QMI8658_FIFO_MODE_STREAM  0x02 // FIFO_CTRL: keep the newest samples
+#define QMI8658_FIFO_SIZE_128     0x0C // FIFO_CTRL: 128 samples
+#define QMI8658_FIFO_FRAME        6    // bytes per FIFO sample, accelerometer only
+#define QMI8658_FIFO_CHUNK        20   // samples per I2C read, fits the Wire buffer
 
 
 typedef enum {
@@ -140,7 +154,7 @@ void QMI8658_Init(void);
 void QMI8658_Loop(void);
 void QMI8658_transmit(uint8_t addr, uint8_t data);
 uint8_t QMI8658_receive(uint8_t addr);
-void QMI8658_CTRL9_Write(uint8_t command);
+bool QMI8658_CTRL9_Write(uint8_t command);
 void QMI8658_sensor_update();
 void QMI8658_update_if_needed();
 void setAccODR(acc_odr_t odr);
@@ -158,4 +172,8 @@ float getGyroX();
 float getGyroY();
 float getGyroZ();
 void getAccelerometer(void);
-void getGyroscope(void);
\ No newline at end of file
+void getGyroscope(void);
+void QMI8658_FIFO_Init(acc_odr_t odr);
+uint16_t QMI8658_FIFO_Read(int16_t (*raw)[3], uint16_t max);
+float QMI8658_Acc_LSB_G(void);
+float QMI8658_Acc_ODR_Hz(void);
\ No newline at end of file
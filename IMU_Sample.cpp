@@ -0,0 +1,137 @@
+#include "IMU_Sample.h"
+
+static IMUSample latest = {0};
+static portMUX_TYPE sample_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Full-rate ring: one writer (the driver task), any number of readers with their own cursor
+static IMURaw ring[IMU_RING_LEN];
+static volatile uint32_t ring_head = 0;     // total samples ever pushed
+
+// Sample clock: the driver task's one time base for FIFO samples
+static volatile uint32_t clock_last_us = 0;  // time given to the newest sample so far
+static uint64_t clock_total_us = 0;          // the same without the 32-bit wrap
+static volatile bool clock_valid = false;
+
+/**
+ * Publish a new sample. Safe to call from any task; readers on the other core
+ * always see a complete sample.
+ * @param t_us capture time in micros()
+ */
+void IMU_Sample_Publish(float x, float y, float z, uint32_t t_us)
+{
+    uint32_t now = micros();
+    portENTER_CRITICAL(&sample_lock);
+    latest.seq++;
+    latest.t_us = t_us;
+    latest.t_pub_us = now;
+    latest.x = x;
+    latest.y = y;
+    latest.z = z;
+    portEXIT_CRITICAL(&sample_lock);
+}
+
+/**
+ * Copy the most recent sample.
+ * @return false if nothing has been published yet
+ */
+bool IMU_Sample_Latest(IMUSample *out)
+{
+    portENTER_CRITICAL(&sample_lock);
+    *out = latest;
+    portEXIT_CRITICAL(&sample_lock);
+    return out->seq != 0;
+}
+
+/**
+ * Append full-rate samples. Only the driver task may call this.
+ * @param raw x, y, z in sensor LSB
+ */
+void IMU_Ring_Push(const int16_t (*raw)[3], uint16_t n)
+{
+    uint32_t head = ring_head;
+    for (uint16_t i = 0; i < n; i++, head++) {
+        IMURaw *r = &ring[head & (IMU_RING_LEN - 1)];
+        r->x = raw[i][0];
+        r->y = raw[i][1];
+        r->z = raw[i][2];
+    }
+    __sync_synchronize();       // samples are visible before the new head
+    ring_head = head;
+}
+
+uint32_t IMU_Ring_Head(void)
+{
+    return ring_head;
+}
+
+/**
+ * Copy samples the reader has not seen yet. A reader that fell more than
+ * IMU_RING_LEN behind skips to the oldest sample still held.
+ * @param cursor reader position, start with IMU_Ring_Head()
+ * @return number of samples copied
+ */
+uint16_t IMU_Ring_Read(uint32_t *cursor, IMURaw *out, uint16_t max)
+{
+    uint32_t head = ring_head;
+    __sync_synchronize();
+    if (head - *cursor > IMU_RING_LEN) *cursor = head - IMU_RING_LEN;
+    uint32_t avail = head - *cursor;
+    uint16_t n = avail < max ? avail : max;
+    for (uint16_t i = 0; i < n; i++)
+        out[i] = ring[(*cursor + i) & (IMU_RING_LEN - 1)];
+    *cursor += n;
+    return n;
+}
+
+/**
+ * Timestamp a batch of FIFO samples on one continuous clock. Every sample is one step after
+ * the previous one, the step being the nominal period pulled towards micros() by at most
+ * 1/IMU_CLOCK_SLEW, so times never go backwards or repeat across batches and the clock follows
+ * the sensor's real rate. Only when it falls more than IMU_CLOCK_GAP periods behind (the FIFO
+ * overflowed) does it jump forward. Driver task only.
+ * @param n         samples in the batch, the newest read at t_us
+ * @param t_us      micros() at the FIFO read
+ * @param period_us nominal sample period
+ * @param step_us   out: time between consecutive samples of this batch
+ * @return time of the first sample; sample i is at return + i * step_us
+ */
+uint32_t IMU_Clock_Stamp(uint16_t n, uint32_t t_us, uint32_t period_us, uint32_t *step_us)
+{
+    uint32_t first_us = t_us - (uint32_t)(n - 1) * period_us;   // where micros() puts the batch
+    uint32_t last = clock_last_us;
+    int32_t err = (int32_t)(first_us - (last + period_us));
+    if (!clock_valid || err > (int32_t)(IMU_CLOCK_GAP * period_us)) {
+        clock_valid = true;
+        *step_us = period_us;
+    } else {
+        // Spread the error over the batch, bounded so the step stays close to the period
+        int32_t bound = (int32_t)(n * period_us / IMU_CLOCK_SLEW);
+        if (err > bound) err = bound;
+        if (err < -bound) err = -bound;
+        *step_us = period_us + err / (int32_t)n;
+        first_us = last + *step_us;
+    }
+    uint32_t newest = first_us + (uint32_t)(n - 1) * *step_us;
+    clock_total_us += newest - last;    // the clock only moves forward
+    clock_last_us = newest;
+    return first_us;
+}
+
+/**
+ * Extend a sample clock time to 64 bits, so it does not wrap after 71 minutes. Valid for any
+ * sample time up to the newest one and less than 71 minutes older, e.g. the batch just stamped.
+ * Driver task only.
+ */
+uint64_t IMU_Clock_Extend(uint32_t t_us)
+{
+    return clock_total_us - (uint32_t)(clock_last_us - t_us);
+}
+
+/**
+ * Time given to the newest sample so far, or micros() before the first one. Any task; a sample
+ * stamped later is strictly newer.
+ */
+uint32_t IMU_Clock_Last(void)
+{
+    return clock_valid ? clock_last_us : micros();
+}
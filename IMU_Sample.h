@@ -0,0 +1,34 @@
+#pragma once
+#include <Arduino.h>
+
+#define IMU_RING_LEN    4096    // full-rate samples kept, power of two (4 s at 1 kHz)
+#define IMU_CLOCK_SLEW  8       // sample clock may run 1/8 of a period fast or slow to follow micros()
+#define IMU_CLOCK_GAP   4       // periods behind micros() after which the clock jumps (samples were lost)
+
+// Latest accelerometer sample, published by the driver task and read by the UI
+typedef struct {
+    uint32_t seq;       // incremented on every publish, 0 = nothing published yet
+    uint32_t t_us;      // capture time, micros()
+    uint32_t t_pub_us;  // publish time, micros()
+    float x;            // acceleration in g
+    float y;
+    float z;
+} IMUSample;
+
+// One full-rate accelerometer sample as read from the sensor
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t z;
+} IMURaw;
+
+void IMU_Sample_Publish(float x, float y, float z, uint32_t t_us);
+bool IMU_Sample_Latest(IMUSample *out);
+
+void IMU_Ring_Push(const int16_t (*raw)[3], uint16_t n);
+uint32_t IMU_Ring_Head(void);
+uint16_t IMU_Ring_Read(uint32_t *cursor, IMURaw *out, uint16_t max);
+
+uint32_t IMU_Clock_Stamp(uint16_t n, uint32_t t_us, uint32_t period_us, uint32_t *step_us);
+uint32_t IMU_Clock_Last(void);
+uint64_t IMU_Clock_Extend(uint32_t t_us);
@@ -0,0 +1,106 @@
+#include "LVGL_Blend.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "ui.h"
+
+#if __has_include("src/draw/sw/lv_draw_sw.h")
+#include "src/draw/sw/lv_draw_sw.h"
+#else
+#include "lvgl/src/draw/sw/lv_draw_sw.h"
+#endif
+
+#if LVGL_BLEND_FAST
+
+/**
+ * draw_img_decoded hook: plain, untransformed TRUE_COLOR_ALPHA images go to
+ * Lvgl_Blend_RGB565A8, everything else to LVGL's software renderer.
+ */
+static void Lvgl_Blend_Img_Decoded(lv_draw_ctx_t *draw_ctx, const lv_draw_img_dsc_t *draw_dsc,
+                                   const lv_area_t *coords, const uint8_t *map_p, lv_img_cf_t cf)
+{
+    lv_area_t blend_area;
+    if (cf != LV_IMG_CF_TRUE_COLOR_ALPHA ||
+        draw_dsc->angle != 0 || draw_dsc->zoom != LV_IMG_ZOOM_NONE ||
+        draw_dsc->recolor_opa != LV_OPA_TRANSP || draw_dsc->opa < LV_OPA_MAX ||
+        draw_dsc->blend_mode != LV_BLEND_MODE_NORMAL ||
+        !_lv_area_intersect(&blend_area, coords, draw_ctx->clip_area) ||
+        lv_draw_mask_is_any(&blend_area)) {
+        lv_draw_sw_img_decoded(draw_ctx, draw_dsc, coords, map_p, cf);
+        return;
+    }
+
+    lv_coord_t buf_w = lv_area_get_width(draw_ctx->buf_area);
+    lv_coord_t img_w = lv_area_get_width(coords);
+    lv_color_t *dest = (lv_color_t *)draw_ctx->buf +
+                       (blend_area.y1 - draw_ctx->buf_area->y1) * buf_w +
+                       (blend_area.x1 - draw_ctx->buf_area->x1);
+    const uint8_t *src = map_p +
+                         ((blend_area.y1 - coords->y1) * img_w + (blend_area.x1 - coords->x1)) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+    Lvgl_Blend_RGB565A8(dest, buf_w, src, img_w,
+                        lv_area_get_width(&blend_area), lv_area_get_height(&blend_area));
+}
+
+#endif
+
+/**
+ * Software renderer context, with the sprite fast path when the colour format
+ * is native RGB565 (the kernel is in LVGL_Blend_Kernel.cpp).
+ */
+void Lvgl_Blend_Ctx_Init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+#if LVGL_BLEND_FAST
+    draw_ctx->draw_img_decoded = Lvgl_Blend_Img_Decoded;
+#endif
+}
+
+/**
+ * Blend the G-force dot into an off-screen buffer through LVGL's generic
+ * path and through the fast path, and print the cycle counts of both.
+ */
+void Lvgl_Blend_Benchmark(void)
+{
+#if !LVGL_BLEND_FAST
+    printf("Blend benchmark: fast path off, colour format is not native RGB565\r\n");
+#else
+    const lv_img_dsc_t *img = &ui_img_dot_asset_2_png;
+    const uint32_t rounds = 1000;
+
+    lv_area_t area = {0, 0, (lv_coord_t)(img->header.w - 1), (lv_coord_t)(img->header.h - 1)};
+    lv_color_t *buf = (lv_color_t *)heap_caps_malloc(img->header.w * img->header.h * sizeof(lv_color_t),
+                                                     MALLOC_CAP_INTERNAL);
+    lv_draw_sw_ctx_t *ctx = (lv_draw_sw_ctx_t *)lv_mem_alloc(sizeof(lv_draw_sw_ctx_t));
+    if (!buf || !ctx) {
+        printf("Blend benchmark: out of memory\r\n");
+        heap_caps_free(buf);
+        lv_mem_free(ctx);
+        return;
+    }
+    lv_draw_sw_init_ctx(lv_disp_get_default()->driver, &ctx->base_draw);
+    ctx->base_draw.buf = buf;
+    ctx->base_draw.buf_area = &area;
+    ctx->base_draw.clip_area = &area;
+
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+
+    uint32_t start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < rounds; i++)
+        lv_draw_sw_img_decoded(&ctx->base_draw, &dsc, &area, img->data, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    uint32_t generic = (ESP.getCycleCount() - start) / rounds;
+
+    start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < rounds; i++)
+        Lvgl_Blend_Img_Decoded(&ctx->base_draw, &dsc, &area, img->data, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    uint32_t fast = (ESP.getCycleCount() - start) / rounds;
+
+    printf("Blend %dx%d RGB565A8: generic %lu cycles, fast %lu cycles (%.1fx)\r\n",
+           img->header.w, img->header.h, (unsigned long)generic, (unsigned long)fast,
+           fast ? (float)generic / fast : 0.0f);
+
+    lv_draw_sw_deinit_ctx(lv_disp_get_default()->driver, &ctx->base_draw);
+    lv_mem_free(ctx);
+    heap_caps_free(buf);
+#endif
+}
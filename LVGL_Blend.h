@@ -0,0 +1,31 @@
+#pragma once
+
+#include <lvgl.h>
+
+// Set to 1 to print cycle counts of the generic vs. fast image blend at boot
+#ifndef LVGL_BLEND_BENCHMARK
+#define LVGL_BLEND_BENCHMARK  0
+#endif
+
+// The fast path reads and writes native RGB565; any other colour format uses LVGL's blend
+#if LV_COLOR_DEPTH == 16 && !LV_COLOR_16_SWAP
+#define LVGL_BLEND_FAST       1
+#else
+#define LVGL_BLEND_FAST       0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void Lvgl_Blend_Ctx_Init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx);  // lv_draw_sw context with the RGB565+A8 sprite fast path
+#if LVGL_BLEND_FAST
+void Lvgl_Blend_RGB565A8(lv_color_t *dest, lv_coord_t dest_stride,
+                         const uint8_t *src, lv_coord_t src_stride,
+                         lv_coord_t w, lv_coord_t h);                    // Alpha blend an LV_IMG_CF_TRUE_COLOR_ALPHA block over RGB565
+#endif
+void Lvgl_Blend_Benchmark(void);
+
+#ifdef __cplusplus
+}
+#endif
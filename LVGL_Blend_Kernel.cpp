@@ -0,0 +1,47 @@
+// RGB565+A8 blend kernel of LVGL_Blend, kept free of LVGL internals so the host
+// benchmark (tools/blend_bench.cpp) builds this same file.
+#include "LVGL_Blend.h"
+#include <Arduino.h>
+
+#if LVGL_BLEND_FAST
+
+/**
+ * Mix one RGB565 pixel over another.
+ * Both colours are spread to 0b00000gggggg00000rrrrr000000bbbbb so the three
+ * channels scale together with a single multiply by a 5-bit alpha.
+ */
+static inline uint16_t blend_565(uint16_t fg, uint16_t bg, uint8_t alpha)
+{
+    uint32_t a = (alpha + 4) >> 3;                                  // 0..32
+    uint32_t f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81F;
+    uint32_t b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81F;
+    uint32_t r = ((((f - b) * a) >> 5) + b) & 0x07E0F81F;
+    return (uint16_t)(r | (r >> 16));
+}
+
+/**
+ * Alpha blend a block of LV_IMG_CF_TRUE_COLOR_ALPHA pixels (RGB565 low, high, A8) over RGB565.
+ * @param dest        first destination pixel
+ * @param dest_stride destination row length in pixels
+ * @param src         first source pixel (3 bytes per pixel)
+ * @param src_stride  source row length in pixels
+ */
+void IRAM_ATTR Lvgl_Blend_RGB565A8(lv_color_t *dest, lv_coord_t dest_stride,
+                                   const uint8_t *src, lv_coord_t src_stride,
+                                   lv_coord_t w, lv_coord_t h)
+{
+    for (lv_coord_t y = 0; y < h; y++) {
+        uint16_t *d = (uint16_t *)dest;
+        const uint8_t *s = src;
+        for (lv_coord_t x = 0; x < w; x++, s += LV_IMG_PX_SIZE_ALPHA_BYTE) {
+            uint8_t a = s[2];
+            if (a == 0) continue;                                   // most of a sprite is fully transparent
+            uint16_t c = (uint16_t)(s[0] | (s[1] << 8));
+            d[x] = (a >= LV_OPA_MAX) ? c : blend_565(c, d[x], a);
+        }
+        dest += dest_stride;
+        src += src_stride * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+}
+
+#endif
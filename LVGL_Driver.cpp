@@ -1,19 +1,30 @@
 #include "LVGL_Driver.h"
 #include "Display_ST7701.h"
 #include "Touch_CST820.h"
+#include "LVGL_Blend.h"
+#include "Frame_Scheduler.h"
+#include "Frame_Profiler.h"
+#include "Latency_Trace.h"
 
 static lv_disp_draw_buf_t draw_buf;
 static lv_color_t *buf1 = NULL;
 static lv_color_t *buf2 = NULL;
 lv_disp_drv_t disp_drv;
 
+static SemaphoreHandle_t lvgl_mutex = NULL;
+static TaskHandle_t lvgl_task = NULL;
+
 static void lv_tick_task(void *arg) {
-    lv_tick_inc(5);
+    lv_tick_inc(EXAMPLE_LVGL_TICK_PERIOD_MS);
 }
 
 void Lvgl_Display_LCD(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+    uint32_t start = micros();
     if (panel_handle)
         esp_lcd_panel_draw_bitmap(panel_handle, area->x1, area->y1, area->x2 + 1, area->y2 + 1, color_p);
+    Frame_Profiler_Flush(micros() - start, lv_area_get_size(area));
+    if (lv_disp_flush_is_last(drv))
+        Latency_Trace_Flush_Done();
     lv_disp_flush_ready(drv);
 }
 
@@ -30,6 +41,7 @@ void Lvgl_Touchpad_Read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data) {
 
 void Lvgl_Init(void) {
     Serial.println("Initializing LVGL...");
+    lvgl_mutex = xSemaphoreCreateRecursiveMutex();
     lv_init();
 
     const uint32_t buf_lines = 40;
@@ -43,9 +55,11 @@ void Lvgl_Init(void) {
     disp_drv.hor_res = 480;
     disp_drv.ver_res = 480;
     disp_drv.flush_cb = Lvgl_Display_LCD;
+    disp_drv.draw_ctx_init = Lvgl_Blend_Ctx_Init;   // software renderer + RGB565A8 sprite fast path
     disp_drv.draw_buf = &draw_buf;
     disp_drv.user_data = panel_handle;
     lv_disp_drv_register(&disp_drv);
+    Frame_Profiler_Init();
 
     static lv_indev_drv_t indev_drv;
     lv_indev_drv_init(&indev_drv);
@@ -59,15 +73,54 @@ void Lvgl_Init(void) {
         .name = "lvgl_tick"
     };
     esp_timer_create(&tick_args, &lvgl_tick_timer);
-    esp_timer_start_periodic(lvgl_tick_timer, 5000);
+    esp_timer_start_periodic(lvgl_tick_timer, EXAMPLE_LVGL_TICK_PERIOD_MS * 1000);
 
     lv_obj_t *scr = lv_disp_get_scr_act(lv_disp_get_default());
     lv_obj_set_style_bg_color(scr, lv_color_hex(0x000000), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, LV_PART_MAIN);
 
+#if LVGL_BLEND_BENCHMARK
+    Lvgl_Blend_Benchmark();
+#endif
+
     Serial.println("LVGL initialized successfully!");
 }
 
 void Lvgl_Loop(void) {
     lv_timer_handler();
 }
+
+void lvgl_lock(void) {
+    xSemaphoreTakeRecursive(lvgl_mutex, portMAX_DELAY);
+}
+
+bool lvgl_trylock(uint32_t timeout_ms) {
+    return xSemaphoreTakeRecursive(lvgl_mutex, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+
+void lvgl_unlock(void) {
+    xSemaphoreGiveRecursive(lvgl_mutex);
+}
+
+// Runs the frame scheduler under the LVGL lock and sleeps until the next frame or LVGL timer is due
+static void Lvgl_Task(void *parameter) {
+    while (1) {
+        lvgl_lock();
+        uint32_t wait_ms = Frame_Scheduler_Loop();
+        lvgl_unlock();
+        vTaskDelay(max(pdMS_TO_TICKS(wait_ms), (TickType_t)1));
+    }
+}
+
+void Lvgl_Task_Start(void) {
+    if (lvgl_task) return;
+    xTaskCreatePinnedToCore(
+        Lvgl_Task,
+        "LVGL Task",
+        LVGL_TASK_STACK,
+        NULL,
+        LVGL_TASK_PRIORITY,
+        &lvgl_task,
+        LVGL_TASK_CORE
+    );
+}
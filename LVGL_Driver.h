@@ -12,6 +12,10 @@
 
 #define EXAMPLE_LVGL_TICK_PERIOD_MS  2
 
+#define LVGL_TASK_CORE      1
+#define LVGL_TASK_PRIORITY  2
+#define LVGL_TASK_STACK     8192
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -25,6 +29,12 @@ void example_increase_lvgl_tick(void *arg);
 
 void Lvgl_Init(void);
 void Lvgl_Loop(void);
+void Lvgl_Task_Start(void);                                                                 // Run LVGL in its own task from now on
+
+// Every LVGL call made outside the LVGL task must hold this lock (recursive)
+void lvgl_lock(void);
+bool lvgl_trylock(uint32_t timeout_ms);
+void lvgl_unlock(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,132 @@
+#include "LVGL_NumLabel.h"
+#include <string.h>
+
+/**
+ * Format hundredths as "[-]d.dd" / "[-]dd.dd" without printf or floats.
+ * @param buf   at least NUMLABEL_TEXT_LEN bytes
+ * @param centi value in hundredths, clamped to +-99.99
+ * @return number of characters written
+ */
+uint8_t NumLabel_Format(char *buf, int32_t centi)
+{
+    char *p = buf;
+    if (centi < 0) {
+        *p++ = '-';
+        centi = -centi;
+    }
+    if (centi > 9999) centi = 9999;
+
+    uint32_t whole = centi / 100;
+    uint32_t frac = centi % 100;
+    if (whole >= 10) *p++ = '0' + whole / 10;
+    *p++ = '0' + whole % 10;
+    *p++ = '.';
+    *p++ = '0' + frac / 10;
+    *p++ = '0' + frac % 10;
+    *p = '\0';
+    return p - buf;
+}
+
+/**
+ * Left edge of the first glyph of a centred line, as lv_draw_label places it.
+ */
+static lv_coord_t NumLabel_Line_Start(const lv_area_t *content, const char *txt,
+                                      const lv_font_t *font, lv_coord_t space)
+{
+    lv_coord_t line_w = lv_txt_get_width(txt, strlen(txt), font, space, LV_TEXT_FLAG_NONE);
+    return content->x1 + (lv_area_get_width(content) - line_w) / 2;
+}
+
+/**
+ * Horizontal extent of one glyph drawn with its origin at x.
+ * @return advance width including kerning against the next letter
+ */
+static lv_coord_t NumLabel_Glyph_Span(const lv_font_t *font, char letter, char next,
+                                      lv_coord_t x, lv_coord_t *x1, lv_coord_t *x2)
+{
+    lv_font_glyph_dsc_t g;
+    if (!letter || !lv_font_get_glyph_dsc(font, &g, letter, next)) {
+        *x1 = x;
+        *x2 = x - 1;
+        return 0;
+    }
+    *x1 = x + LV_MIN(0, g.ofs_x);
+    *x2 = x + LV_MAX((lv_coord_t)g.adv_w, (lv_coord_t)(g.ofs_x + g.box_w)) - 1;
+    return g.adv_w;
+}
+
+/**
+ * Invalidate the columns of every glyph that changes between the current text and next.
+ * Glyphs keep their area when both the character and its position are unchanged.
+ */
+static void NumLabel_Invalidate_Diff(NumLabel *nl, const char *next)
+{
+    const lv_font_t *font = lv_obj_get_style_text_font(nl->label, LV_PART_MAIN);
+    lv_coord_t space = lv_obj_get_style_text_letter_space(nl->label, LV_PART_MAIN);
+    lv_area_t content;
+    lv_obj_get_content_coords(nl->label, &content);
+
+    const char *prev = nl->text;
+    lv_coord_t x_prev = NumLabel_Line_Start(&content, prev, font, space);
+    lv_coord_t x_next = NumLabel_Line_Start(&content, next, font, space);
+    size_t len_prev = strlen(prev);
+    size_t len_next = strlen(next);
+
+    for (size_t i = 0; i < LV_MAX(len_prev, len_next); i++) {
+        char cp = i < len_prev ? prev[i] : 0;
+        char cn = i < len_next ? next[i] : 0;
+        lv_coord_t p1, p2, n1, n2;
+        lv_coord_t adv_prev = NumLabel_Glyph_Span(font, cp, cp ? prev[i + 1] : 0, x_prev, &p1, &p2);
+        lv_coord_t adv_next = NumLabel_Glyph_Span(font, cn, cn ? next[i + 1] : 0, x_next, &n1, &n2);
+
+        if (cp != cn || x_prev != x_next) {
+            lv_area_t dirty = {LV_MIN(p1, n1), content.y1, LV_MAX(p2, n2), content.y2};
+            if (dirty.x2 >= dirty.x1) lv_obj_invalidate_area(nl->label, &dirty);
+        }
+        x_prev += adv_prev + space;
+        x_next += adv_next + space;
+    }
+}
+
+/**
+ * Take over an existing label: fix its width to the widest value so the
+ * layout never changes, and point it at the NumLabel's own text buffer.
+ */
+void NumLabel_Init(NumLabel *nl, lv_obj_t *label)
+{
+    nl->label = label;
+    nl->value = 0;
+    NumLabel_Format(nl->text, 0);
+    if (!label) return;
+
+    const lv_font_t *font = lv_obj_get_style_text_font(label, LV_PART_MAIN);
+    lv_coord_t space = lv_obj_get_style_text_letter_space(label, LV_PART_MAIN);
+    lv_coord_t digit_w = 0;
+    for (char c = '0'; c <= '9'; c++)
+        digit_w = LV_MAX(digit_w, (lv_coord_t)lv_font_get_glyph_width(font, c, 0));
+    lv_coord_t width = 4 * digit_w + lv_font_get_glyph_width(font, '-', 0) +
+                       lv_font_get_glyph_width(font, '.', 0) + 5 * space;
+
+    lv_label_set_long_mode(label, LV_LABEL_LONG_CLIP);
+    lv_obj_set_width(label, width + lv_obj_get_style_pad_left(label, LV_PART_MAIN) +
+                            lv_obj_get_style_pad_right(label, LV_PART_MAIN));
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_label_set_text_static(label, nl->text);
+}
+
+/**
+ * Show a new value. Does nothing if the value is unchanged; otherwise the text is
+ * rewritten in place and only the changed glyphs are invalidated, bypassing
+ * lv_label's re-layout and whole-object invalidation.
+ * @param centi value in hundredths
+ */
+void NumLabel_Set(NumLabel *nl, int32_t centi)
+{
+    if (!nl->label || centi == nl->value) return;
+
+    char next[NUMLABEL_TEXT_LEN];
+    NumLabel_Format(next, centi);
+    NumLabel_Invalidate_Diff(nl, next);
+    memcpy(nl->text, next, sizeof(next));
+    nl->value = centi;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <lvgl.h>
+
+#define NUMLABEL_TEXT_LEN   8       // "-99.99" + terminator, rounded up
+
+// Label that shows a fixed-point value with two decimals and only redraws the glyphs that changed
+typedef struct {
+    lv_obj_t *label;
+    int32_t value;                  // last rendered value in hundredths
+    char text[NUMLABEL_TEXT_LEN];   // label text, shown through lv_label_set_text_static
+} NumLabel;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void NumLabel_Init(NumLabel *nl, lv_obj_t *label);
+void NumLabel_Set(NumLabel *nl, int32_t centi);
+uint8_t NumLabel_Format(char *buf, int32_t centi);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,105 @@
+#include "Latency_Trace.h"
+
+// One sample is traced at a time; a newer sample replaces one still in flight
+enum { TRACE_IDLE, TRACE_UPDATED, TRACE_FLUSHED };
+
+static volatile uint8_t trace_state = TRACE_IDLE;
+static uint32_t trace_t[LATENCY_STAGES + 1];        // capture, then the stage timestamps
+static uint32_t hist[LATENCY_STAGES][LATENCY_BINS];
+static uint32_t traced = 0;
+static uint32_t replaced = 0;
+static portMUX_TYPE trace_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * Start tracing a sample once the widgets have been updated from it.
+ * Called by the frame scheduler right after the update callback.
+ */
+void Latency_Trace_Update(const IMUSample *sample)
+{
+    uint32_t now = micros();
+    portENTER_CRITICAL(&trace_lock);
+    if (trace_state != TRACE_IDLE) replaced++;
+    trace_t[0] = sample->t_us;
+    trace_t[1 + LATENCY_PUBLISH] = sample->t_pub_us;
+    trace_t[1 + LATENCY_UPDATE] = now;
+    trace_state = TRACE_UPDATED;
+    portEXIT_CRITICAL(&trace_lock);
+}
+
+/**
+ * The frame holding the traced update has been handed to the panel.
+ * Called from the flush callback for the last area of a refresh.
+ */
+void Latency_Trace_Flush_Done(void)
+{
+    uint32_t now = micros();
+    portENTER_CRITICAL(&trace_lock);
+    if (trace_state == TRACE_UPDATED) {
+        trace_t[1 + LATENCY_FLUSH] = now;
+        trace_state = TRACE_FLUSHED;
+    }
+    portEXIT_CRITICAL(&trace_lock);
+}
+
+/**
+ * Vsync interrupt: the flushed frame starts scanning out, close the trace.
+ */
+void IRAM_ATTR Latency_Trace_Vsync(void)
+{
+    if (trace_state != TRACE_FLUSHED) return;
+    uint32_t now = micros();
+    portENTER_CRITICAL_ISR(&trace_lock);
+    trace_t[1 + LATENCY_VSYNC] = now;
+    for (uint8_t s = 0; s < LATENCY_STAGES; s++) {
+        uint32_t bin = (trace_t[1 + s] - trace_t[0]) / LATENCY_BIN_US;
+        hist[s][bin < LATENCY_BINS ? bin : LATENCY_BINS - 1]++;
+    }
+    traced++;
+    trace_state = TRACE_IDLE;
+    portEXIT_CRITICAL_ISR(&trace_lock);
+}
+
+// Upper edge of the bin holding the given percentile, in us
+static uint32_t Latency_Trace_Percentile(const uint32_t *h, uint32_t total, uint8_t pct)
+{
+    uint32_t target = (total * pct + 99) / 100;
+    uint32_t sum = 0;
+    for (uint32_t b = 0; b < LATENCY_BINS; b++) {
+        sum += h[b];
+        if (sum >= target) return (b + 1) * LATENCY_BIN_US;
+    }
+    return LATENCY_BINS * LATENCY_BIN_US;
+}
+
+/**
+ * Print p50/p99 latency from capture to the end of every stage.
+ */
+void Latency_Trace_Report(void)
+{
+    static const char *names[LATENCY_STAGES] = {"publish", "update", "flush", "vsync"};
+    static uint32_t copy[LATENCY_STAGES][LATENCY_BINS];
+
+    portENTER_CRITICAL(&trace_lock);
+    memcpy(copy, hist, sizeof(copy));
+    uint32_t total = traced, lost = replaced;
+    portEXIT_CRITICAL(&trace_lock);
+
+    printf("Latency from capture: %lu samples traced, %lu replaced in flight\r\n",
+           (unsigned long)total, (unsigned long)lost);
+    if (!total) return;
+    for (uint8_t s = 0; s < LATENCY_STAGES; s++) {
+        printf("  %-8s p50 %6.1f ms  p99 %6.1f ms\r\n", names[s],
+               Latency_Trace_Percentile(copy[s], total, 50) / 1000.0f,
+               Latency_Trace_Percentile(copy[s], total, 99) / 1000.0f);
+    }
+}
+
+void Latency_Trace_Reset(void)
+{
+    portENTER_CRITICAL(&trace_lock);
+    memset(hist, 0, sizeof(hist));
+    traced = 0;
+    replaced = 0;
+    trace_state = TRACE_IDLE;
+    portEXIT_CRITICAL(&trace_lock);
+}
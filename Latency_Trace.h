@@ -0,0 +1,21 @@
+#pragma once
+#include <Arduino.h>
+#include "IMU_Sample.h"
+
+#define LATENCY_BIN_US      500     // histogram resolution
+#define LATENCY_BINS        256     // 128 ms range, the last bin collects everything above
+
+// Pipeline stages, each timed from the sample's capture
+typedef enum {
+    LATENCY_PUBLISH = 0,    // sensor read done, sample handed to the UI
+    LATENCY_UPDATE,         // widgets updated for this sample
+    LATENCY_FLUSH,          // last area of the frame copied to the panel frame buffer
+    LATENCY_VSYNC,          // first vsync after the flush: scan-out of the new frame starts
+    LATENCY_STAGES
+} LatencyStage;
+
+void Latency_Trace_Update(const IMUSample *sample);
+void Latency_Trace_Flush_Done(void);
+void Latency_Trace_Vsync(void);
+void Latency_Trace_Report(void);
+void Latency_Trace_Reset(void);
@@ -0,0 +1,128 @@
+#include "Log_Format.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * CRC-32 (IEEE 802.3, as zlib), four bits at a time: a 64 byte table is plenty for
+ * one 16 KB block per second and keeps the function usable from any context.
+ * @param crc 0 to start, or the result of the previous call to continue
+ */
+uint32_t Log_Crc32(uint32_t crc, const void *data, uint32_t len)
+{
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+/**
+ * Fill a header for a new file: identity calibration, no wall clock.
+ * Set cal/cal_offset, the rtc_* fields with LOG_FLAG_RTC and device afterwards as needed,
+ * then call Log_Header_Seal.
+ * @param gyro_lsb_dps 0 when the gyro is not logged
+ * @param start_us     time base of the first record
+ * @param session      random id repeated in every block
+ */
+void Log_Header_Init(LogHeader *h, float acc_lsb_g, float gyro_lsb_dps, float odr_hz, uint32_t start_us,
+                     uint32_t session, uint32_t block_size)
+{
+    memset(h, 0, sizeof(*h));
+    h->magic = LOG_MAGIC;
+    h->version = LOG_VERSION;
+    h->header_size = sizeof(LogHeader);
+    h->record_size = sizeof(LogRecord);
+    h->flags = gyro_lsb_dps > 0 ? LOG_FLAG_GYRO : 0;
+    h->acc_lsb_g = acc_lsb_g;
+    h->gyro_lsb_dps = gyro_lsb_dps;
+    h->odr_hz = odr_hz;
+    for (int i = 0; i < 3; i++) h->cal[i][i] = 1.0f;
+    h->start_us = start_us;
+    h->session = session;
+    h->block_size = block_size;
+}
+
+void Log_Header_Seal(LogHeader *h)
+{
+    h->crc = Log_Crc32(0, h, offsetof(LogHeader, crc));
+}
+
+/**
+ * Check that a header is one this code can read.
+ */
+bool Log_Header_Valid(const LogHeader *h)
+{
+    return h->magic == LOG_MAGIC && h->version >= LOG_VERSION_MIN && h->version <= LOG_VERSION &&
+           h->header_size == sizeof(LogHeader) && h->record_size == sizeof(LogRecord) &&
+           h->crc == Log_Crc32(0, h, offsetof(LogHeader, crc));
+}
+
+/**
+ * Fill in the LogBlockHeader at the start of a block whose records are already in place.
+ */
+void Log_Block_Seal(void *block, uint32_t session, uint32_t seq, uint16_t payload_len)
+{
+    LogBlockHeader *b = (LogBlockHeader *)block;
+    b->magic = LOG_BLOCK_MAGIC;
+    b->session = session;
+    b->seq = seq;
+    b->payload_len = payload_len;
+    b->reserved = 0;
+    b->crc = Log_Crc32(Log_Crc32(0, b, offsetof(LogBlockHeader, crc)), b + 1, payload_len);
+}
+
+void Log_Index_Seal(LogIndexEntry *e)
+{
+    e->magic = LOG_INDEX_MAGIC;
+    e->crc = Log_Crc32(0, e, offsetof(LogIndexEntry, crc));
+}
+
+bool Log_Index_Valid(const LogIndexEntry *e)
+{
+    return e->magic == LOG_INDEX_MAGIC && e->crc == Log_Crc32(0, e, offsetof(LogIndexEntry, crc));
+}
+
+/**
+ * Check that a block was written completely, by this session and at this position.
+ * @param seq expected block index
+ */
+bool Log_Block_Valid(const void *block, uint32_t block_size, uint32_t session, uint32_t seq)
+{
+    const LogBlockHeader *b = (const LogBlockHeader *)block;
+    return b->magic == LOG_BLOCK_MAGIC && b->session == session && b->seq == seq &&
+           b->payload_len <= block_size - sizeof(LogBlockHeader) &&
+           b->crc == Log_Crc32(Log_Crc32(0, b, offsetof(LogBlockHeader, crc)), b + 1, b->payload_len);
+}
+
+/**
+ * Build a record for a sample taken at t_us.
+ * @param last_us time of the previous record, start_us before the first one; advanced to t_us
+ */
+void Log_Record_Pack(LogRecord *r, uint32_t *last_us, uint32_t t_us,
+                     const int16_t accel[3], const int16_t gyro[3])
+{
+    uint32_t dt = t_us - *last_us;
+    r->dt_us = dt > LOG_DT_MAX ? LOG_DT_MAX : dt;
+    *last_us = t_us;
+    for (int i = 0; i < 3; i++) {
+        r->accel[i] = accel[i];
+        r->gyro[i] = gyro ? gyro[i] : 0;
+    }
+}
+
+/**
+ * Acceleration of a record in g, with the header's scale and calibration applied.
+ */
+void Log_Record_Accel_G(const LogHeader *h, const LogRecord *r, float out[3])
+{
+    float a[3];
+    for (int i = 0; i < 3; i++) a[i] = r->accel[i] * h->acc_lsb_g - h->cal_offset[i];
+    for (int i = 0; i < 3; i++) out[i] = h->cal[i][0] * a[0] + h->cal[i][1] * a[1] + h->cal[i][2] * a[2];
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Binary telemetry log: one LogHeader (a full sector), then blocks of block_size bytes,
+// each a LogBlockHeader followed by fixed-size LogRecords and zero padding, or with
+// LOG_FLAG_PACKED by the records coded as in Log_Pack.h.
+// Shared by the firmware and the host decoder (tools/glog_decode.cpp), little endian.
+// Blocks carry the session id, a sequence number counting from 0 and a CRC, so the valid
+// part of a file that was never closed is the run of blocks whose sequence matches their
+// position; everything after it is reserved space or an interrupted write.
+#define LOG_MAGIC           0x474F4C47u     // "GLOG"
+#define LOG_BLOCK_MAGIC     0x4B4C4247u     // "GBLK"
+#define LOG_INDEX_MAGIC     0x58444947u     // "GIDX"
+#define LOG_VERSION         3               // 3: optional LOG_FLAG_PACKED
+#define LOG_VERSION_MIN     2               // oldest version readers accept
+#define LOG_HEADER_SIZE     512
+#define LOG_DT_MAX          0x3FFFFFFFu     // longer gaps are clamped, ~18 minutes
+#define LOG_DEVICE_LEN      32
+
+#define LOG_FLAG_GYRO       0x0001          // gyro fields hold data
+#define LOG_FLAG_RTC        0x0002          // rtc_* fields hold the wall clock at start_us
+#define LOG_FLAG_PACKED     0x0004          // block payloads are coded with Log_Pack.h
+#define LOG_FLAG_EVENT      0x0008          // event capture around trigger_us, see Black_Box.h
+
+#define LOG_TRIGGER_G       1               // acceleration magnitude away from 1 g
+#define LOG_TRIGGER_JERK    2               // change of acceleration between two samples
+#define LOG_TRIGGER_MANUAL  3               // touch gesture or serial command
+
+#define LOG_INDEX_OPEN      0x0001          // session still being written, or never closed
+#define LOG_INDEX_RECOVERED 0x0002          // length repaired after a power cut
+
+typedef struct __attribute__((packed)) {
+    uint32_t dt_us;         // since the previous record, or since start_us for the first one
+    int16_t accel[3];       // LSB, see LogHeader.acc_lsb_g
+    int16_t gyro[3];        // LSB, see LogHeader.gyro_lsb_dps
+} LogRecord;
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;         // LOG_BLOCK_MAGIC
+    uint32_t session;       // LogHeader.session of the file it belongs to
+    uint32_t seq;           // block index in the file
+    uint16_t payload_len;   // record (or packed) bytes that follow, the rest of the block is padding
+    uint16_t reserved;
+    uint32_t crc;           // Log_Crc32 of the header fields above and the payload
+} LogBlockHeader;
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    uint16_t record_size;
+    uint16_t flags;
+    float acc_lsb_g;
+    float gyro_lsb_dps;
+    float odr_hz;
+    float cal[3][3];        // accel in g after calibration: cal * (raw * acc_lsb_g - cal_offset)
+    float cal_offset[3];
+    uint16_t rtc_year;
+    uint8_t rtc_month, rtc_day, rtc_hour, rtc_minute, rtc_second;
+    uint8_t trigger;        // LOG_FLAG_EVENT: LOG_TRIGGER_* that fired
+    uint32_t start_us;      // micros() the first record's dt_us counts from
+    char device[LOG_DEVICE_LEN];
+    uint32_t session;       // random, ties blocks to this file
+    uint32_t block_size;    // bytes per block, header included
+    uint32_t trigger_us;    // LOG_FLAG_EVENT: micros() of the sample that fired the trigger
+    uint8_t reserved[LOG_HEADER_SIZE - 132];
+    uint32_t crc;           // Log_Crc32 of everything above, set by Log_Header_Seal
+} LogHeader;
+
+// One entry per session in the session index, entry n at byte n * sizeof(LogIndexEntry)
+typedef struct __attribute__((packed)) {
+    uint32_t magic;         // LOG_INDEX_MAGIC
+    uint32_t number;        // file number, see SD_SESSION_NAME_FMT
+    uint32_t session;       // LogHeader.session
+    uint16_t rtc_year;
+    uint8_t rtc_month, rtc_day, rtc_hour, rtc_minute, rtc_second;
+    uint8_t rtc_valid;
+    uint16_t flags;         // LOG_INDEX_*
+    uint16_t peak_mg;       // highest combined horizontal G
+    uint32_t duration_ms;
+    uint32_t bytes;         // file length, header included
+    uint32_t records;
+    uint16_t mean_mg;       // mean combined horizontal G over the session
+    uint16_t p95_mg;        // its 95th percentile
+    uint8_t reserved[20];
+    uint32_t crc;           // Log_Crc32 of everything above
+} LogIndexEntry;
+
+#ifdef __cplusplus
+static_assert(sizeof(LogRecord) == 16, "LogRecord layout");
+static_assert(sizeof(LogBlockHeader) == 20, "LogBlockHeader layout");
+static_assert(sizeof(LogHeader) == LOG_HEADER_SIZE, "LogHeader layout");
+static_assert(sizeof(LogIndexEntry) == 64, "LogIndexEntry layout");
+extern "C" {
+#endif
+
+uint32_t Log_Crc32(uint32_t crc, const void *data, uint32_t len);                                          // CRC-32 (IEEE), start with 0
+void Log_Header_Init(LogHeader *h, float acc_lsb_g, float gyro_lsb_dps, float odr_hz, uint32_t start_us,
+                     uint32_t session, uint32_t block_size);                                                // Identity calibration, no RTC
+void Log_Header_Seal(LogHeader *h);                                                                        // After the last field is set
+bool Log_Header_Valid(const LogHeader *h);
+void Log_Block_Seal(void *block, uint32_t session, uint32_t seq, uint16_t payload_len);                   // Header at the start of block
+bool Log_Block_Valid(const void *block, uint32_t block_size, uint32_t session, uint32_t seq);
+void Log_Index_Seal(LogIndexEntry *e);
+bool Log_Index_Valid(const LogIndexEntry *e);
+void Log_Record_Pack(LogRecord *r, uint32_t *last_us, uint32_t t_us,
+                     const int16_t accel[3], const int16_t gyro[3]);                                       // gyro may be NULL
+void Log_Record_Accel_G(const LogHeader *h, const LogRecord *r, float out[3]);                            // Scaled and calibrated
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,192 @@
+#include "Log_Pack.h"
+#include <string.h>
+
+#define LOG_PACK_SUM_MAX    0xFFFFFFu   // largest step counted into a channel's statistics, keeps sums from overflowing
+
+// Record as channel values; dt_us is carried as int32 and differences wrap, so any value survives
+static void Log_Pack_Fields(const LogRecord *r, int32_t v[LOG_PACK_CHANNELS])
+{
+    v[0] = (int32_t)r->dt_us;
+    for (int i = 0; i < 3; i++) {
+        v[1 + i] = r->accel[i];
+        v[4 + i] = r->gyro[i];
+    }
+}
+
+// Start every block with a small parameter; the first differences adapt it within a few records
+static void Log_Pack_Stats_Init(uint32_t sum[LOG_PACK_CHANNELS], uint16_t *n)
+{
+    for (int c = 0; c < LOG_PACK_CHANNELS; c++) sum[c] = 4;
+    *n = 1;
+}
+
+// Rice parameter: smallest k with n * 2^k >= sum, i.e. about log2 of the mean coded value
+static inline uint8_t Log_Pack_K(uint32_t sum, uint16_t n)
+{
+    uint8_t k = 0;
+    while (k < 31 && ((uint32_t)n << k) < sum) k++;
+    return k;
+}
+
+static inline void Log_Pack_Stats_Update(uint32_t sum[LOG_PACK_CHANNELS], uint16_t *n)
+{
+    if (++*n < LOG_PACK_RESET) return;
+    for (int c = 0; c < LOG_PACK_CHANNELS; c++) sum[c] = (sum[c] + 1) >> 1;
+    *n >>= 1;
+}
+
+static inline void Log_Pack_Bits(LogPacker *p, uint32_t v, uint8_t bits)
+{
+    p->acc |= (uint64_t)v << p->nbits;
+    p->nbits += bits;
+    while (p->nbits >= 8) {
+        p->out[p->pos++] = (uint8_t)p->acc;
+        p->acc >>= 8;
+        p->nbits -= 8;
+    }
+}
+
+/**
+ * Start a packed payload.
+ * @param payload first byte after the LogBlockHeader
+ * @param cap     bytes available there
+ */
+void Log_Pack_Begin(LogPacker *p, void *payload, uint32_t cap)
+{
+    p->out = (uint8_t *)payload;
+    p->cap = cap;
+    p->pos = 2;                                     // record count, filled in by Log_Pack_End
+    p->acc = 0;
+    p->nbits = 0;
+    p->count = 0;
+    memset(p->prev, 0, sizeof(p->prev));
+    Log_Pack_Stats_Init(p->sum, &p->n);
+}
+
+/**
+ * Code one record. Refuses it, leaving the block as it was, when the worst case
+ * might not fit; the caller then ends this block and starts the next one.
+ */
+bool Log_Pack_Add(LogPacker *p, const LogRecord *r)
+{
+    if (p->pos + LOG_PACK_RECORD_MAX + 1 > p->cap || p->count == UINT16_MAX) return false;
+
+    int32_t v[LOG_PACK_CHANNELS];
+    Log_Pack_Fields(r, v);
+    for (int c = 0; c < LOG_PACK_CHANNELS; c++) {
+        int32_t d = (int32_t)((uint32_t)v[c] - (uint32_t)p->prev[c]);
+        uint32_t z = ((uint32_t)d << 1) ^ (uint32_t)(d >> 31);
+        uint8_t k = Log_Pack_K(p->sum[c], p->n);
+        uint32_t q = z >> k;
+        if (q < LOG_PACK_ESCAPE) {
+            Log_Pack_Bits(p, (1u << q) - 1, q + 1); // q ones and a zero
+            if (k) Log_Pack_Bits(p, z & ((1u << k) - 1), k);
+        } else {
+            Log_Pack_Bits(p, (1u << LOG_PACK_ESCAPE) - 1, LOG_PACK_ESCAPE);
+            Log_Pack_Bits(p, z, 32);
+        }
+        p->prev[c] = v[c];
+        p->sum[c] += (z < LOG_PACK_SUM_MAX ? z : LOG_PACK_SUM_MAX);
+    }
+    Log_Pack_Stats_Update(p->sum, &p->n);
+    p->count++;
+    return true;
+}
+
+/**
+ * Write out the last bits and the record count.
+ * @return payload bytes, count included
+ */
+uint32_t Log_Pack_End(LogPacker *p)
+{
+    if (p->nbits) Log_Pack_Bits(p, 0, 8 - p->nbits);
+    p->out[0] = (uint8_t)p->count;
+    p->out[1] = (uint8_t)(p->count >> 8);
+    return p->pos;
+}
+
+/**
+ * Start reading the records of a block that passed Log_Block_Valid, packed or not
+ * as the file header says.
+ */
+void Log_Unpack_Begin(LogUnpacker *u, const LogHeader *h, const void *block)
+{
+    const LogBlockHeader *b = (const LogBlockHeader *)block;
+    u->in = (const uint8_t *)(b + 1);
+    u->len = b->payload_len;
+    u->acc = 0;
+    u->nbits = 0;
+    u->packed = (h->flags & LOG_FLAG_PACKED) != 0;
+    if (u->packed) {
+        u->left = u->len >= 2 ? u->in[0] | (u->in[1] << 8) : 0;
+        u->pos = 2;
+        memset(u->prev, 0, sizeof(u->prev));
+        Log_Pack_Stats_Init(u->sum, &u->n);
+    } else {
+        u->left = u->len / sizeof(LogRecord);
+        u->pos = 0;
+    }
+}
+
+// Top up the bit buffer; past the end of the payload it reads zeros
+static inline void Log_Unpack_Fill(LogUnpacker *u)
+{
+    while (u->nbits <= 56) {
+        uint64_t byte = u->pos < u->len ? u->in[u->pos] : 0;
+        u->pos++;
+        u->acc |= byte << u->nbits;
+        u->nbits += 8;
+    }
+}
+
+static inline uint32_t Log_Unpack_Bits(LogUnpacker *u, uint8_t bits)
+{
+    uint32_t v = (uint32_t)(u->acc & ((1ull << bits) - 1));
+    u->acc >>= bits;
+    u->nbits -= bits;
+    return v;
+}
+
+/**
+ * Next record of the block.
+ * @return false after the last one, or when a packed payload ends early
+ */
+bool Log_Unpack_Next(LogUnpacker *u, LogRecord *r)
+{
+    if (!u->left) return false;
+    u->left--;
+    if (!u->packed) {
+        memcpy(r, u->in + u->pos, sizeof(LogRecord));
+        u->pos += sizeof(LogRecord);
+        return true;
+    }
+
+    int32_t v[LOG_PACK_CHANNELS];
+    for (int c = 0; c < LOG_PACK_CHANNELS; c++) {
+        Log_Unpack_Fill(u);
+        uint32_t ones = ~(uint32_t)u->acc;
+        uint32_t q = ones ? __builtin_ctz(ones) : 32;
+        uint32_t z;
+        if (q < LOG_PACK_ESCAPE) {
+            uint8_t k = Log_Pack_K(u->sum[c], u->n);
+            Log_Unpack_Bits(u, q + 1);
+            z = (q << k) | (k ? Log_Unpack_Bits(u, k) : 0);
+        } else {
+            Log_Unpack_Bits(u, LOG_PACK_ESCAPE);
+            z = Log_Unpack_Bits(u, 32);
+        }
+        int32_t d = (int32_t)((z >> 1) ^ (0u - (z & 1)));
+        v[c] = (int32_t)((uint32_t)u->prev[c] + (uint32_t)d);
+        u->prev[c] = v[c];
+        u->sum[c] += (z < LOG_PACK_SUM_MAX ? z : LOG_PACK_SUM_MAX);
+    }
+    Log_Pack_Stats_Update(u->sum, &u->n);
+    if (u->pos * 8 - u->nbits > u->len * 8) return false;   // ran past the payload: damaged count
+
+    r->dt_us = (uint32_t)v[0];
+    for (int i = 0; i < 3; i++) {
+        r->accel[i] = (int16_t)v[1 + i];
+        r->gyro[i] = (int16_t)v[4 + i];
+    }
+    return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Log_Format.h"
+
+// Block compression for LOG_FLAG_PACKED logs. Each block is coded on its own, so a
+// damaged or missing block costs only its own records and recovery works as before.
+// Every record field (dt_us, accel, gyro) is a channel: the difference to the previous
+// record is zigzag mapped and Rice coded with a parameter that follows the channel's recent
+// magnitude (LOCO-I style), so steady time steps and an unused gyro cost one bit per field
+// and sensor noise a few bits more than its amplitude. Differences that do not fit the
+// current parameter are escaped and stored in full. Coding is a fixed amount of integer
+// work per record, no tables and no search.
+// Packed payload: record count (uint16), then the bit stream, least significant bit first.
+#define LOG_PACK_CHANNELS   7       // dt_us, accel[3], gyro[3]
+#define LOG_PACK_ESCAPE     20      // quotients from here on are stored as a raw 32-bit value
+#define LOG_PACK_RESET      64      // channel statistics are halved every so many records
+#define LOG_PACK_RECORD_MAX ((LOG_PACK_CHANNELS * (LOG_PACK_ESCAPE + 32) + 7) / 8)  // worst case bytes
+
+typedef struct {
+    uint8_t *out;
+    uint32_t cap;                   // payload bytes available
+    uint32_t pos;                   // bytes written
+    uint64_t acc;                   // bits not yet written, lowest first
+    uint8_t nbits;
+    uint16_t count;                 // records in the block
+    int32_t prev[LOG_PACK_CHANNELS];
+    uint32_t sum[LOG_PACK_CHANNELS];
+    uint16_t n;                     // records since the last statistics reset
+} LogPacker;
+
+typedef struct {
+    const uint8_t *in;
+    uint32_t len;
+    uint32_t pos;
+    uint64_t acc;
+    uint8_t nbits;
+    uint16_t left;                  // records not yet returned
+    bool packed;
+    int32_t prev[LOG_PACK_CHANNELS];
+    uint32_t sum[LOG_PACK_CHANNELS];
+    uint16_t n;
+} LogUnpacker;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void Log_Pack_Begin(LogPacker *p, void *payload, uint32_t cap);
+bool Log_Pack_Add(LogPacker *p, const LogRecord *r);                                       // false: block is full
+uint32_t Log_Pack_End(LogPacker *p);                                                       // Payload bytes
+void Log_Unpack_Begin(LogUnpacker *u, const LogHeader *h, const void *block);              // Raw or packed block
+bool Log_Unpack_Next(LogUnpacker *u, LogRecord *r);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,227 @@
+#include "Log_Replay.h"
+#include <esp_heap_caps.h>
+#include "Gyro_QMI8658.h"
+#include "Log_Pack.h"
+#include "SD_Async.h"
+
+static TaskHandle_t replay_task = NULL;
+static volatile bool replay_active = false;
+static volatile bool replay_stop = false;
+static volatile uint32_t replay_steps = 0;      // single steps requested and not yet taken
+
+static char replay_path[SD_ASYNC_PATH_LEN];    // read through the file service, one block per request
+static LogHeader replay_header;
+static uint8_t *replay_block = NULL;
+static uint32_t replay_seq = 0;                 // next block to read
+static LogUnpacker replay_unpack;               // records of the current block
+static float replay_speed = 1.0f;               // 0: single step
+static float replay_scale = 1.0f;               // log LSB -> live LSB
+static uint64_t replay_log_us = 0;              // log time of the last sample handed over
+static uint64_t replay_target_us = 0;           // log time replayed up to
+static uint32_t replay_samples = 0;
+static LogRecord replay_pending;                // read ahead, not yet due or no room in the ring
+static bool replay_have_pending = false;
+
+// Replay task -> driver task, one writer and one reader
+static int16_t (*replay_ring)[3] = NULL;        // PSRAM, live accelerometer LSB
+static uint32_t *replay_ring_ms = NULL;         // PSRAM, log time of each sample in ms
+static volatile uint32_t ring_head = 0;         // samples ever written
+static volatile uint32_t ring_tail = 0;         // samples ever read
+
+// Next record of the file, reading and checking a new block when the current one is used up
+static bool Log_Replay_Next(LogRecord *r)
+{
+    while (!Log_Unpack_Next(&replay_unpack, r)) {
+        uint32_t offset = sizeof(LogHeader) + replay_seq * replay_header.block_size;
+        if (SD_Async_Read_Wait(replay_path, offset, replay_block, replay_header.block_size) !=
+                (int32_t)replay_header.block_size ||
+            !Log_Block_Valid(replay_block, replay_header.block_size, replay_header.session, replay_seq))
+            return false;
+        replay_seq++;
+        Log_Unpack_Begin(&replay_unpack, &replay_header, replay_block);
+    }
+    return true;
+}
+
+static int16_t Log_Replay_Rescale(int16_t v)
+{
+    int32_t s = lroundf(v * replay_scale);
+    return s > INT16_MAX ? INT16_MAX : s < INT16_MIN ? INT16_MIN : s;
+}
+
+/**
+ * Queue every record up to replay_target_us for the driver task. When the ring is full the
+ * rest waits for the next wake-up, so a driver that falls behind slows the replay down.
+ * @return false at the end of the log
+ */
+static bool Log_Replay_Catch_Up(void)
+{
+    uint32_t head = ring_head;
+    while (true) {
+        if (!replay_have_pending && !(replay_have_pending = Log_Replay_Next(&replay_pending))) break;
+        if (replay_log_us + replay_pending.dt_us > replay_target_us) break;
+        if (head - ring_tail >= LOG_REPLAY_RING) break;
+        replay_log_us += replay_pending.dt_us;
+        int16_t *s = replay_ring[head & (LOG_REPLAY_RING - 1)];
+        for (int i = 0; i < 3; i++) s[i] = Log_Replay_Rescale(replay_pending.accel[i]);
+        replay_ring_ms[head & (LOG_REPLAY_RING - 1)] = (uint32_t)(replay_log_us / 1000);
+        replay_have_pending = false;
+        replay_samples++;
+        head++;
+    }
+    __sync_synchronize();       // samples are visible before the new head
+    ring_head = head;
+    return replay_have_pending;
+}
+
+static void Log_Replay_Task(void *parameter)
+{
+    uint32_t last_us = micros();
+    while (!replay_stop) {
+        vTaskDelay(pdMS_TO_TICKS(LOG_REPLAY_PERIOD_MS));
+        uint32_t now = micros();
+        if (replay_speed > 0) {
+            replay_target_us += (uint64_t)((now - last_us) * replay_speed);
+        } else if (replay_steps) {
+            replay_steps--;
+            replay_target_us += LOG_REPLAY_STEP_US;
+        } else {
+            last_us = now;
+            continue;
+        }
+        last_us = now;
+        if (!Log_Replay_Catch_Up()) break;
+    }
+
+    printf("Replay: %s after %lu samples, %.1f s of log\r\n", replay_stop ? "stopped" : "finished",
+           (unsigned long)replay_samples, replay_log_us / 1e6);
+    heap_caps_free(replay_block);
+    replay_block = NULL;
+    replay_active = false;
+    replay_task = NULL;
+    vTaskDelete(NULL);
+}
+
+/**
+ * Allocate the ring to the driver task. Call once before the first Log_Replay_Start.
+ */
+bool Log_Replay_Init(void)
+{
+    replay_ring = (int16_t (*)[3])heap_caps_malloc(LOG_REPLAY_RING * sizeof(*replay_ring), MALLOC_CAP_SPIRAM);
+    replay_ring_ms = (uint32_t *)heap_caps_malloc(LOG_REPLAY_RING * sizeof(*replay_ring_ms), MALLOC_CAP_SPIRAM);
+    if (!replay_ring || !replay_ring_ms) {
+        printf("Replay: out of memory\r\n");
+        heap_caps_free(replay_ring);
+        heap_caps_free(replay_ring_ms);
+        replay_ring = NULL;
+        replay_ring_ms = NULL;
+    }
+    return replay_ring != NULL;
+}
+
+/**
+ * Replay a recorded log into the sink.
+ * @param path  full path of a log file, e.g. from SD_Session_Path
+ * @param speed 1 for real time, >1 faster, 0 to advance only with Log_Replay_Step
+ */
+bool Log_Replay_Start(const char *path, float speed)
+{
+    if (Log_Replay_Active() || !replay_ring || strlen(path) >= sizeof(replay_path)) return false;
+    strcpy(replay_path, path);
+    int32_t got = SD_Async_Read_Wait(replay_path, 0, &replay_header, sizeof(replay_header));
+    if (got < 0) {
+        printf("Replay: cannot open %s\r\n", path);
+        return false;
+    }
+    if (got != sizeof(replay_header) || !Log_Header_Valid(&replay_header) ||
+        !(replay_block = (uint8_t *)heap_caps_malloc(replay_header.block_size, MALLOC_CAP_SPIRAM))) {
+        printf("Replay: %s is not a readable log\r\n", path);
+        return false;
+    }
+
+    replay_seq = 0;
+    memset(&replay_unpack, 0, sizeof(replay_unpack));   // no block yet: the first read fetches one
+    replay_speed = speed;
+    replay_scale = replay_header.acc_lsb_g / QMI8658_Acc_LSB_G();
+    replay_log_us = replay_target_us = 0;
+    replay_samples = 0;
+    replay_have_pending = false;
+    replay_steps = 0;
+    replay_stop = false;
+    replay_active = true;
+    if (xTaskCreatePinnedToCore(Log_Replay_Task, "Log Replay", 4096, NULL, LOG_REPLAY_TASK_PRIORITY,
+                                &replay_task, LOG_REPLAY_TASK_CORE) != pdPASS) {
+        replay_active = false;
+        heap_caps_free(replay_block);
+        replay_block = NULL;
+        return false;
+    }
+    if (fabsf(replay_header.odr_hz - QMI8658_Acc_ODR_Hz()) > 1.0f)     // e.g. a log written with SD_LOG_DIVIDER
+        printf("Replay: log has %.0f Hz, live rate is %.0f Hz; spectrum frequencies will be off\r\n",
+               replay_header.odr_hz, QMI8658_Acc_ODR_Hz());
+    if (speed > 0) printf("Replay: %s at %.1fx\r\n", path, speed);
+    else printf("Replay: %s, single step (%u ms per step)\r\n", path, LOG_REPLAY_STEP_US / 1000);
+    return true;
+}
+
+/**
+ * Advance a single-step replay by LOG_REPLAY_STEP_US of log time.
+ */
+void Log_Replay_Step(void)
+{
+    if (replay_active && replay_speed <= 0) replay_steps++;
+}
+
+/**
+ * End the replay early. The task closes the file on its next wake-up.
+ */
+void Log_Replay_Stop(void)
+{
+    if (replay_active) replay_stop = true;
+}
+
+/**
+ * Collect replayed samples that are due, oldest first, in the live accelerometer's LSB.
+ * Driver task only. After Log_Replay_Stop whatever is still queued is dropped.
+ * @param t_ms out: log time of each sample in ms, from the start of the log
+ * @return number of samples copied
+ */
+uint16_t Log_Replay_Read(int16_t (*raw)[3], uint32_t *t_ms, uint16_t max)
+{
+    uint32_t head = ring_head;
+    __sync_synchronize();
+    uint32_t tail = ring_tail;
+    if (replay_stop) {
+        ring_tail = head;
+        return 0;
+    }
+    uint32_t avail = head - tail;
+    uint16_t n = avail < max ? avail : max;
+    for (uint16_t i = 0; i < n; i++, tail++) {
+        memcpy(raw[i], replay_ring[tail & (LOG_REPLAY_RING - 1)], sizeof(raw[i]));
+        t_ms[i] = replay_ring_ms[tail & (LOG_REPLAY_RING - 1)];
+    }
+    __sync_synchronize();       // copied before the slots are handed back
+    ring_tail = tail;
+    return n;
+}
+
+/**
+ * True while samples come from a log instead of the sensor, until the driver task has
+ * collected the last of them.
+ */
+bool Log_Replay_Active(void)
+{
+    return replay_active || ring_head != ring_tail;
+}
+
+void Log_Replay_Print(void)
+{
+    if (!replay_active) {
+        printf("Replay: idle\r\n");
+        return;
+    }
+    printf("Replay: %.1f s of log, %lu samples, block %lu, %s\r\n", replay_log_us / 1e6,
+           (unsigned long)replay_samples, (unsigned long)replay_seq,
+           replay_speed > 0 ? "running" : "single step");
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <Arduino.h>
+#include "Log_Format.h"
+
+#define LOG_REPLAY_PERIOD_MS    20      // task wake-up, batches everything that fell due since the last one
+#define LOG_REPLAY_STEP_US      50000   // one single step: as much log time as one driver pass
+#define LOG_REPLAY_RING         2048    // samples in flight to the driver task, power of two; 2 s at 1x
+#define LOG_REPLAY_TASK_CORE    0
+#define LOG_REPLAY_TASK_PRIORITY 2      // below the driver task, above spectrum and SD logging
+
+// The replay task reads the log and paces it; the samples wait in a ring until the driver task
+// collects them with Log_Replay_Read, so the sample pipeline keeps its single writer.
+bool Log_Replay_Init(void);
+bool Log_Replay_Start(const char *path, float speed);
+uint16_t Log_Replay_Read(int16_t (*raw)[3], uint32_t *t_ms, uint16_t max);
+void Log_Replay_Step(void);
+void Log_Replay_Stop(void);
+bool Log_Replay_Active(void);
+void Log_Replay_Print(void);
@@ -6,23 +6,122 @@
 #include "Display_ST7701.h"
 #include "Touch_CST820.h"
 #include "LVGL_Driver.h"
+#include "IMU_Sample.h"
+#include "Frame_Scheduler.h"
+#include "Frame_Profiler.h"
+#include "UI_Benchmark.h"
+#include "Gauge_Face.h"
+#include "GForce_Screen.h"
+#include "Latency_Trace.h"
+#include "GG_Envelope.h"
+#include "GForce_Stats.h"
+#include "Vib_Spectrum.h"
+#include "SD_Card.h"
+#include "SD_Session.h"
+#include "SD_Async.h"
+#include "Log_Replay.h"
+#include "Black_Box.h"
+#include "Log_Format.h"
+#include "RTC_PCF85063.h"
 #include "ui.h"  // SquareLine generated UI
 
 // ------------------ Global Variables ------------------
-float x = 0, y = 0, z = 0;  // Accelerometer
+// Friction circle and statistics of the session, filled by the driver task from the sensor, the
+// circle drawn by the UI. The lap circle restarts with every lap. A replay fills its own pair, so it
+// never reaches the session's index entry.
+static GGEnvelope session_envelope, lap_envelope, replay_envelope;
+static GStats session_stats, replay_stats;
+// Which live circle the gauge shows
+static volatile bool overlay_session = false;
+// Sample clock time of the last sample that made it into the SD log; records carry the delta to it
+static volatile uint32_t log_last_us;
+// Samples since the last one logged, for SD_LOG_DIVIDER
+static uint8_t log_skip = 0;
+
+// ------------------ Sample Pipeline ------------------
+// Full-rate processing shared by the sensor and log replay, driver task only.
+// Envelopes and statistics of one sample source; lap_env may be NULL. t_ms is each sample's time
+// on the source's own clock: the extended sample clock live, log time in a replay, so the rolling
+// statistics follow the data at any replay speed.
+static void Accumulate_Samples(const int16_t (*raw)[3], const uint32_t *t_ms, uint16_t n, GGEnvelope *env,
+                               GGEnvelope *lap_env, GStats *stats)
+{
+    float lsb = QMI8658_Acc_LSB_G();
+    for (uint16_t i = 0; i < n; i++) {
+        float ax = raw[i][0] * lsb, ay = raw[i][1] * lsb;
+        GG_Envelope_Add(env, ax, ay);
+        if (lap_env) GG_Envelope_Add(lap_env, ax, ay);
+        GForce_Stats_Add(stats, ax, ay, t_ms[i]);
+    }
+}
+
+// What the screens show: spectrum ring, then the newest sample to the UI stamped with t_us
+static void Show_Samples(const int16_t (*raw)[3], uint16_t n, uint32_t t_us)
+{
+    IMU_Ring_Push(raw, n);
+    float lsb = QMI8658_Acc_LSB_G();
+    IMU_Sample_Publish(raw[n - 1][0] * lsb, raw[n - 1][1] * lsb, raw[n - 1][2] * lsb, t_us);
+}
 
 // ------------------ Driver Task ------------------
 void Driver_Loop(void *parameter)
 {
+    static int16_t raw[128][3];     // one full sensor FIFO
+    static int16_t replayed[128][3];
+    static uint32_t raw_ms[128], replayed_ms[128];     // sample times for the statistics
+
     while (1)
     {
-        QMI8658_Loop();  // Updates Accel internally
+        uint32_t t_us = micros();
+        uint16_t n = QMI8658_FIFO_Read(raw, 128);  // every sample since the last pass; Accel = newest
         BAT_Get_Volts();
 
-        // Copy latest accelerometer values
-        x = Accel.x;
-        y = Accel.y;
-        z = Accel.z;
+        if (n) {
+            // One continuous time base for every sample, see IMU_Clock_Stamp
+            uint32_t period_us = (uint32_t)(1000000.0f / QMI8658_Acc_ODR_Hz());
+            uint32_t step_us;
+            uint32_t first_us = IMU_Clock_Stamp(n, t_us, period_us, &step_us);
+
+            // Every sample to the black box ring, which watches for events; same stamps as the log
+            Black_Box_Add(raw, n, first_us, step_us);
+
+            // Raw samples to the SD log, every SD_LOG_DIVIDER-th one. A dropped record leaves the
+            // time base alone, so the next delta spans the gap. Only a batch stamped before a new
+            // session's start can hold samples older than it; those are left out and counted.
+            uint32_t late = 0;
+            for (uint16_t i = 0; i < n; i++) {
+                if (++log_skip < SD_LOG_DIVIDER) continue;
+                log_skip = 0;
+                LogRecord rec;
+                uint32_t last_us = log_last_us;
+                uint32_t sample_us = first_us + i * step_us;
+                if ((int32_t)(sample_us - last_us) <= 0) {
+                    late++;
+                    continue;
+                }
+                Log_Record_Pack(&rec, &last_us, sample_us, raw[i], NULL);
+                if (SD_Log_Write(&rec, sizeof(rec))) log_last_us = last_us;
+            }
+            if (late) SD_Log_Drop(late);
+
+            // The session's envelopes and statistics always follow the sensor
+            uint64_t first64_us = IMU_Clock_Extend(first_us);
+            for (uint16_t i = 0; i < n; i++) raw_ms[i] = (uint32_t)((first64_us + (uint64_t)i * step_us) / 1000);
+            Accumulate_Samples(raw, raw_ms, n, &session_envelope, &lap_envelope, &session_stats);
+        }
+
+        // The screens follow the sensor unless a recorded session is being replayed; the log
+        // keeps recording the sensor either way. Replayed samples are collected here, so only
+        // this task ever feeds the pipeline.
+        if (Log_Replay_Active()) {
+            uint16_t m;
+            while ((m = Log_Replay_Read(replayed, replayed_ms, 128)) > 0) {
+                Accumulate_Samples(replayed, replayed_ms, m, &replay_envelope, NULL, &replay_stats);
+                Show_Samples(replayed, m, micros());
+            }
+        } else if (n) {
+            Show_Samples(raw, n, t_us);
+        }
 
         vTaskDelay(pdMS_TO_TICKS(50));
     }
@@ -42,7 +141,11 @@ void Driver_Init()
     Set_Backlight(100);
 
     QMI8658_Init();
+    QMI8658_FIFO_Init(acc_odr_norm_1000);
     BAT_Init();
+    PCF85063_Init();
+    GForce_Stats_Init(&session_stats);
+    GForce_Stats_Init(&replay_stats);
 
     // Create a background task for drivers
     xTaskCreatePinnedToCore(
@@ -56,27 +159,146 @@ void Driver_Init()
     );
 }
 
-// ------------------ G-Force Screen Update ------------------
-void Lvgl_GForce_Loop()
+// ------------------ SD Log Session ------------------
+// The recorded session's combined G for its index entry, in milli-g; false before the first sample
+static bool Session_G_mg(uint16_t *peak, uint16_t *mean, uint16_t *p95)
+{
+    GStatSummary g;
+    if (!GForce_Stats_Get(&session_stats, GSTATS_SESSION, GSTATS_COMBINED, &g)) return false;
+    *peak = (uint16_t)lroundf(g.max * 1000);
+    *mean = (uint16_t)lroundf(g.mean * 1000);
+    *p95 = (uint16_t)lroundf(g.p95 * 1000);
+    return true;
+}
+
+// Close the running session, if any, with its final G summary, then start over: envelopes and
+// statistics empty, a new log file stamped with the sensor scales and the wall clock
+static void Log_Session_Begin()
+{
+    uint16_t peak = 0, mean = 0, p95 = 0;
+    Session_G_mg(&peak, &mean, &p95);
+    SD_Session_End(peak, mean, p95);
+    GG_Envelope_Reset(&session_envelope);
+    GG_Envelope_Reset(&lap_envelope);
+    GForce_Stats_Reset(&session_stats);
+
+    LogHeader header;
+    log_last_us = IMU_Clock_Last();        // the log starts after the newest sample stamped so far
+    Log_Header_Init(&header, QMI8658_Acc_LSB_G(), 0, QMI8658_Acc_ODR_Hz() / SD_LOG_DIVIDER, log_last_us,
+                    esp_random(), SD_LOG_BLOCK);
+    PCF85063_Read_Time(&datetime);
+    if (datetime.year >= 2024) {           // an unset clock reads 1970
+        header.flags |= LOG_FLAG_RTC;
+        header.rtc_year = datetime.year;
+        header.rtc_month = datetime.month;
+        header.rtc_day = datetime.day;
+        header.rtc_hour = datetime.hour;
+        header.rtc_minute = datetime.minute;
+        header.rtc_second = datetime.second;
+    }
+    strncpy(header.device, "ESP32-S3 GForce", LOG_DEVICE_LEN - 1);
+    if (SD_LOG_PACK) header.flags |= LOG_FLAG_PACKED;
+    Log_Header_Seal(&header);
+    SD_Session_Begin(&header);
+}
+
+// Newest session in the index that is closed and not the one being recorded. Not simply the
+// second newest: the open session may have failed to start, or a damaged entry may sit in between.
+static bool Last_Finished_Session(LogIndexEntry *e)
+{
+    uint32_t open_number;
+    bool recording = SD_Session_Number(&open_number);
+    for (uint32_t i = SD_Session_Count(); i-- > 0;) {
+        if (!SD_Session_Get(i, e) || (e->flags & LOG_INDEX_OPEN)) continue;
+        if (!recording || e->number != open_number) return true;
+    }
+    return false;
+}
+
+// Replay the newest finished session (the open one is being recorded) through the sample
+// pipeline, into the replay envelope and statistics, which start empty; stops a replay that is running
+static void Replay_Last_Session(float speed)
+{
+    if (Log_Replay_Active()) {
+        Log_Replay_Stop();
+        return;
+    }
+    LogIndexEntry e;
+    if (!Last_Finished_Session(&e)) {
+        printf("Replay: no finished session on the card\r\n");
+        return;
+    }
+    char path[48];
+    SD_Session_Path(&e, path, sizeof(path));
+    GG_Envelope_Reset(&replay_envelope);
+    GForce_Stats_Reset(&replay_stats);
+    Log_Replay_Start(path, speed);
+}
+
+// ------------------ Session Pages ------------------
+// The session index, newest first, SESSION_PAGE entries per call. Read through the file service,
+// so the caller never waits for the card; a list on screen would fill its rows from the callback.
+#define SESSION_PAGE 8
+static LogIndexEntry session_page[SESSION_PAGE];
+static uint32_t session_page_end = 0;       // the next page ends below this entry; 0 = newest page
+static volatile bool session_page_busy = false;
+
+static void Session_Page_Done(int32_t bytes, void *user)
 {
-    if (!ui_dot) return;  // make sure UI elements exist
+    uint32_t first = (uint32_t)(uintptr_t)user;
+    for (int32_t k = bytes / (int32_t)sizeof(LogIndexEntry) - 1; k >= 0; k--) {
+        if (Log_Index_Valid(&session_page[k])) SD_Session_Print(&session_page[k]);
+        else printf("  #%lu damaged\r\n", (unsigned long)(first + k));
+    }
+    session_page_busy = false;
+}
 
-    // Center (240, 240) for 480x480 screen
-    // Scale ±1G = ±150 pixels
-    float xpos = 240 - ((x / 9.81f) * 150);
-    float ypos = 240 - ((y / 9.81f) * 150);
+static void Session_Page_Next()
+{
+    uint32_t count = SD_Session_Count();
+    if (session_page_busy || count == 0) return;
+    if (session_page_end == 0 || session_page_end > count) session_page_end = count;
+    uint32_t first = session_page_end > SESSION_PAGE ? session_page_end - SESSION_PAGE : 0;
+    printf("Sessions %lu-%lu of %lu\r\n", (unsigned long)first, (unsigned long)(session_page_end - 1),
+           (unsigned long)count);
+    session_page_busy = true;
+    if (!SD_Session_Read_Async(first, session_page_end - first, session_page, Session_Page_Done,
+                               (void *)(uintptr_t)first)) {
+        session_page_busy = false;
+        return;
+    }
+    session_page_end = first;               // after the oldest page, start over at the newest
+}
 
-    // Clamp for safety
-    xpos = constrain(xpos, 20, 460);
-    ypos = constrain(ypos, 20, 460);
+// ------------------ G-Force Screen ------------------
+// Runs every frame, new sample or not: the overlay shows the replay's envelope while one runs,
+// otherwise the lap's or the session's
+static bool GForce_Frame_Tick(uint32_t present_us)
+{
+    const GGEnvelope *shown = Log_Replay_Active() ? &replay_envelope
+                            : overlay_session     ? &session_envelope : &lap_envelope;
+    return GForce_Screen_Tick(present_us, shown);
+}
 
-    lv_obj_set_pos(ui_dot, (int)xpos, (int)ypos);
+// New lap: the lap's envelope and statistics start over, the session's keep going
+static void New_Lap()
+{
+    GG_Envelope_Reset(&lap_envelope);
+    GForce_Stats_New_Lap(&session_stats);
+}
+
+// Long press on the gauge shows/hides the frame profiler overlay
+static void Profiler_Toggle_cb(lv_event_t *e)
+{
+    LV_UNUSED(e);
+    Frame_Profiler_Toggle_Overlay();
+}
 
-    // Update G-force readouts
-    if (ui_Accel) lv_label_set_text_fmt(ui_Accel, "%.2f", max(y / 9.81f, 0.0f));
-    if (ui_Brake) lv_label_set_text_fmt(ui_Brake, "%.2f", abs(min(y / 9.81f, 0.0f)));
-    if (ui_Left)  lv_label_set_text_fmt(ui_Left,  "%.2f", abs(min(x / 9.81f, 0.0f)));
-    if (ui_Right) lv_label_set_text_fmt(ui_Right, "%.2f", max(x / 9.81f, 0.0f));
+// Swipe up on the gauge marks an event: the black box saves the seconds around it
+static void Event_Mark_cb(lv_event_t *e)
+{
+    LV_UNUSED(e);
+    if (lv_indev_get_gesture_dir(lv_indev_get_act()) == LV_DIR_TOP) Black_Box_Trigger();
 }
 
 // ------------------ Setup ------------------
@@ -89,6 +311,12 @@ void setup()
     // 1️⃣ Initialize all low-level drivers
     Driver_Init();   // I2C, EXIO, sensors, battery
 
+    // Card (D3 is switched through the EXIO expander) and the full-rate sample log
+    SD_Init();
+    Log_Session_Begin();
+    Log_Replay_Init();
+    Black_Box_Init();
+
     // 2️⃣ Initialize LCD hardware
     LCD_Init();      // Sets up ST7701 RGB panel + panel_handle
 
@@ -98,19 +326,91 @@ void setup()
     // 4️⃣ Initialize the SquareLine-generated UI
     Serial.println("Initializing UI...");
     ui_init();
+    GForce_Screen_Init();
+    lv_obj_add_event_cb(ui_gforce, Profiler_Toggle_cb, LV_EVENT_LONG_PRESSED, NULL);
+    lv_obj_add_event_cb(ui_gforce, Event_Mark_cb, LV_EVENT_GESTURE, NULL);
 
     // 5️⃣ Optional confirmation label
     lv_obj_t *label = lv_label_create(lv_scr_act());
     lv_label_set_text(label, "GForce Gauge Ready!");
     lv_obj_center(label);
 
+    // Vibration analyser on the sensor core, fed from the full-rate FIFO samples
+    Vib_Spectrum_Start();
+
+    // 6️⃣ Drive LVGL at a fixed frame rate from its own task on core 1.
+    //    From here on, LVGL calls from other tasks need lvgl_lock()/lvgl_unlock().
+    Frame_Scheduler_Init(FRAME_TARGET_FPS, GForce_Screen_Update);
+    Frame_Scheduler_Set_Tick(GForce_Frame_Tick);
+    Lvgl_Task_Start();
+
     Serial.println("=== Setup Complete ===");
 }
 
 // ------------------ Main Loop ------------------
+// LVGL and the drivers run in their own tasks; this one serves Serial commands and keeps the session index current:
+//   p  dump the frame profiler ring as CSV
+//   o  toggle the frame profiler overlay
+//   b  run the deterministic UI render benchmark
+//   s  cycle the gauge full scale (1.5 / 2.0 / 2.5 G) and re-rasterize the face
+//   l  print motion-to-photon latency percentiles and start a new window
+//   t  print G statistics (rolling, lap, session), of the replay while one runs
+//   n  start a new lap: reset the lap's G-G envelope and statistics
+//   c  show the lap's or the session's G-G envelope on the gauge
+//   r  start a new session: reset the G-G envelopes and all statistics, new SD log file
+//   f  print the dominant vibration frequencies per axis
+//   v  toggle the vibration overlay
+//   w  print SD log statistics
+//   x  flush the SD log to the card
+//   g  benchmark SD block write latency with and without preallocation
+//   i  list the newest logged sessions
+//   y  replay the last finished session at 1x (again to stop)
+//   u  replay the last finished session at 8x (again to stop)
+//   k  single-step replay: start it, then advance 50 ms of log per press
+//   e  mark an event: save the black box window around now
+//   h  print black box state and event counts
+//   a  page through the sessions, newest first, without blocking on the card
+//   q  print file service and read cache statistics
 void loop()
 {
-    Lvgl_GForce_Loop();  // Update moving dot + G values
-    Lvgl_Loop();         // Keep LVGL alive
-    delay(5);
+    while (Serial.available()) {
+        switch (Serial.read()) {
+            case 'p': Frame_Profiler_Dump_CSV(); break;
+            case 'o': Frame_Profiler_Toggle_Overlay(); break;
+            case 'b': UI_Benchmark_Run(GForce_Screen_Update, UI_BENCHMARK_FRAMES); break;
+            case 's':
+                lvgl_lock();
+                Gauge_Face_Set_Scale(Gauge_Face_Full_Scale() >= 2.5f ? 1.5f : Gauge_Face_Full_Scale() + 0.5f, GAUGE_STEP_G);
+                lvgl_unlock();
+                break;
+            case 'l': Latency_Trace_Report(); Latency_Trace_Reset(); break;
+            case 't': GForce_Stats_Print(Log_Replay_Active() ? &replay_stats : &session_stats); break;
+            case 'n': New_Lap(); break;
+            case 'c': overlay_session = !overlay_session; break;
+            case 'r': Log_Session_Begin(); break;
+            case 'f': Vib_Spectrum_Print(); break;
+            case 'v': Vib_Spectrum_Toggle_Overlay(); break;
+            case 'w': SD_Log_Print_Stats(); break;
+            case 'x': SD_Log_Flush(); break;
+            case 'g': SD_Log_Benchmark(SD_LOG_BENCH_BYTES); break;
+            case 'i': SD_Session_List(10); break;
+            case 'y': Replay_Last_Session(1.0f); break;
+            case 'u': Replay_Last_Session(8.0f); break;
+            case 'k': if (Log_Replay_Active()) Log_Replay_Step(); else Replay_Last_Session(0); break;
+            case 'e': Black_Box_Trigger(); break;
+            case 'h': Black_Box_Print(); break;
+            case 'a': Session_Page_Next(); break;
+            case 'q': SD_Async_Print(); break;
+            default: break;
+        }
+    }
+
+    // Keep the logged session's index entry current
+    static uint32_t session_update_ms = 0;
+    if (millis() - session_update_ms >= SD_SESSION_UPDATE_MS) {
+        session_update_ms = millis();
+        uint16_t peak, mean, p95;
+        if (Session_G_mg(&peak, &mean, &p95)) SD_Session_Update(peak, mean, p95);
+    }
+    delay(50);
 }
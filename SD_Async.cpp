@@ -0,0 +1,463 @@
+#include "SD_Async.h"
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <esp_heap_caps.h>
+
+typedef enum {
+    SD_ASYNC_OP_READ = 0,
+    SD_ASYNC_OP_WRITE,
+    SD_ASYNC_OP_LIST,
+    SD_ASYNC_OP_SIZE,
+    SD_ASYNC_OP_MKDIR,
+    SD_ASYNC_OP_INVALIDATE
+} SDAsyncOp;
+
+typedef struct {
+    uint8_t op;
+    uint16_t name_len;              // list: stride of names
+    uint32_t offset;
+    uint32_t len;                   // read/write: bytes, list: entries at most
+    void *buf;
+    SD_Async_cb done;
+    void *user;
+    char path[SD_ASYNC_PATH_LEN];
+    char filter[SD_ASYNC_FILTER_LEN];
+} SDAsyncRequest;
+
+typedef struct {
+    char path[SD_ASYNC_PATH_LEN];   // empty: line unused
+    uint32_t offset;                // multiple of SD_ASYNC_LINE
+    uint32_t len;                   // valid bytes, short at the end of the file
+    uint32_t used;                  // LRU stamp
+} SDAsyncLine;
+
+typedef struct {
+    char path[SD_ASYNC_PATH_LEN];
+    FILE *f;
+    bool writable;
+    uint32_t used;
+} SDAsyncFile;
+
+static QueueHandle_t async_queue = NULL;
+static uint8_t *async_data = NULL;              // SD_ASYNC_LINES * SD_ASYNC_LINE, PSRAM
+static SDAsyncLine async_line[SD_ASYNC_LINES];
+static SDAsyncFile async_file[SD_ASYNC_FILES];
+static uint32_t async_clock = 0;                // LRU time, one tick per use
+static SDAsyncStats async_stats;
+
+// ------------------ Open files ------------------
+
+static void SD_Async_Close(SDAsyncFile *file)
+{
+    if (!file->f) return;
+    fclose(file->f);
+    file->f = NULL;
+    file->path[0] = '\0';
+    file->used = 0;                             // first choice for the next open
+}
+
+static void SD_Async_Close_All(void)
+{
+    for (int i = 0; i < SD_ASYNC_FILES; i++) SD_Async_Close(&async_file[i]);
+}
+
+/**
+ * An open FILE for path, reusing a cached one when it allows the access.
+ * Writing opens "r+b", or creates the file when it does not exist yet.
+ */
+static FILE *SD_Async_Open(const char *path, bool write)
+{
+    SDAsyncFile *victim = &async_file[0];
+    for (int i = 0; i < SD_ASYNC_FILES; i++) {
+        SDAsyncFile *file = &async_file[i];
+        if (file->f && !strcmp(file->path, path)) {
+            if (write && !file->writable) {     // reopen for writing, same slot
+                SD_Async_Close(file);
+                victim = file;
+                break;
+            }
+            file->used = ++async_clock;
+            return file->f;
+        }
+        if (!file->f || file->used < victim->used) victim = file;
+    }
+
+    SD_Async_Close(victim);
+    FILE *f = fopen(path, write ? "r+b" : "rb");
+    if (!f && write) f = fopen(path, "w+b");
+    if (!f) return NULL;
+    async_stats.opens++;
+    strncpy(victim->path, path, SD_ASYNC_PATH_LEN - 1);
+    victim->path[SD_ASYNC_PATH_LEN - 1] = '\0';
+    victim->f = f;
+    victim->writable = write;
+    victim->used = ++async_clock;
+    return f;
+}
+
+// ------------------ Read cache ------------------
+
+// Drop the cached lines of a file, or of every file for an empty path
+static void SD_Async_Drop_Lines(const char *path)
+{
+    for (int i = 0; i < SD_ASYNC_LINES; i++) {
+        if (path[0] && strcmp(async_line[i].path, path)) continue;
+        async_line[i].path[0] = '\0';
+        async_line[i].used = 0;
+    }
+}
+
+// Drop the cached lines and the open handle of a file, or of every file for an empty path
+static void SD_Async_Forget(const char *path)
+{
+    SD_Async_Drop_Lines(path);
+    for (int i = 0; i < SD_ASYNC_FILES; i++)
+        if (async_file[i].f && (!path[0] || !strcmp(async_file[i].path, path))) SD_Async_Close(&async_file[i]);
+}
+
+// The cache line holding offset (a multiple of SD_ASYNC_LINE) of path, loaded on a miss
+static SDAsyncLine *SD_Async_Line(const char *path, uint32_t offset, FILE *f)
+{
+    SDAsyncLine *victim = &async_line[0];
+    for (int i = 0; i < SD_ASYNC_LINES; i++) {
+        SDAsyncLine *line = &async_line[i];
+        if (line->path[0] && line->offset == offset && !strcmp(line->path, path)) {
+            line->used = ++async_clock;
+            async_stats.hits++;
+            return line;
+        }
+        if (!line->path[0] || line->used < victim->used) victim = line;
+    }
+
+    uint8_t *data = async_data + (victim - async_line) * SD_ASYNC_LINE;
+    if (fseek(f, offset, SEEK_SET) != 0) return NULL;
+    victim->len = fread(data, 1, SD_ASYNC_LINE, f);
+    if (ferror(f)) {
+        clearerr(f);
+        victim->path[0] = '\0';
+        victim->used = 0;
+        return NULL;
+    }
+    strcpy(victim->path, path);
+    victim->offset = offset;
+    victim->used = ++async_clock;
+    async_stats.misses++;
+    return victim;
+}
+
+// ------------------ Requests ------------------
+
+static int32_t SD_Async_Do_Read(const SDAsyncRequest *req)
+{
+    FILE *f = SD_Async_Open(req->path, false);
+    if (!f) return -1;
+    uint8_t *out = (uint8_t *)req->buf;
+
+    if (req->len >= SD_ASYNC_BYPASS) {          // one pass straight into the caller's buffer
+        async_stats.bypass++;
+        if (fseek(f, req->offset, SEEK_SET) != 0) return -1;
+        size_t n = fread(out, 1, req->len, f);
+        if (ferror(f)) {
+            clearerr(f);
+            return -1;
+        }
+        return n;
+    }
+
+    uint32_t pos = req->offset, end = req->offset + req->len;
+    while (pos < end) {
+        uint32_t base = pos - pos % SD_ASYNC_LINE;
+        SDAsyncLine *line = SD_Async_Line(req->path, base, f);
+        if (!line) return -1;
+        if (pos - base >= line->len) break;    // end of file
+        uint32_t n = min(end - pos, line->len - (pos - base));
+        memcpy(out, async_data + (line - async_line) * SD_ASYNC_LINE + (pos - base), n);
+        out += n;
+        pos += n;
+    }
+    return pos - req->offset;
+}
+
+// Write and sync; a short write or a failed flush or fsync is -1, never a partial count
+static int32_t SD_Async_Do_Write(const SDAsyncRequest *req)
+{
+    FILE *f = SD_Async_Open(req->path, true);
+    if (!f) return -1;
+    SD_Async_Drop_Lines(req->path);             // cached copies of this file are stale from here on
+    bool ok = (req->offset == SD_ASYNC_APPEND ? fseek(f, 0, SEEK_END) : fseek(f, req->offset, SEEK_SET)) == 0;
+    size_t n = ok ? fwrite(req->buf, 1, req->len, f) : 0;
+    ok = n == req->len;
+    ok = fflush(f) == 0 && ok;                  // flush and sync even after a short write
+    ok = fsync(fileno(f)) == 0 && ok;
+    if (!ok) {
+        clearerr(f);
+        return -1;                              // not all of it is known to be on the card
+    }
+    return n;
+}
+
+// Names of the files in a directory that contain the filter, as Folder_retrieval matched them
+static int32_t SD_Async_Do_List(const SDAsyncRequest *req)
+{
+    DIR *dir = opendir(req->path);
+    if (!dir) return -1;
+    int32_t count = 0;
+    struct dirent *entry;
+    while (count < (int32_t)req->len && (entry = readdir(dir)) != NULL) {
+        if (entry->d_type == DT_DIR || (req->filter[0] && !strstr(entry->d_name, req->filter))) continue;
+        char *name = (char *)req->buf + count * req->name_len;
+        strncpy(name, entry->d_name, req->name_len - 1);
+        name[req->name_len - 1] = '\0';
+        count++;
+    }
+    closedir(dir);
+    return count;
+}
+
+static int32_t SD_Async_Do_Size(const SDAsyncRequest *req)
+{
+    for (int i = 0; i < SD_ASYNC_FILES; i++)    // an open handle may have buffered writes the card has not seen
+        if (async_file[i].f && !strcmp(async_file[i].path, req->path)) fflush(async_file[i].f);
+    struct stat st;
+    return stat(req->path, &st) == 0 ? (int32_t)st.st_size : -1;
+}
+
+// Create a directory; an existing one is fine, a file of that name is not
+static int32_t SD_Async_Do_Mkdir(const SDAsyncRequest *req)
+{
+    struct stat st;
+    if (stat(req->path, &st) == 0) return S_ISDIR(st.st_mode) ? 0 : -1;
+    return mkdir(req->path, 0775) == 0 ? 0 : -1;
+}
+
+static void SD_Async_Task(void *parameter)
+{
+    SDAsyncRequest req;
+    while (1) {
+        if (!xQueueReceive(async_queue, &req, pdMS_TO_TICKS(SD_ASYNC_IDLE_MS))) {
+            SD_Async_Close_All();               // idle: leave the files to the rest of the firmware
+            continue;
+        }
+        uint32_t t0 = micros();
+        int32_t result = -1;
+        switch (req.op) {
+            case SD_ASYNC_OP_READ: result = SD_Async_Do_Read(&req); break;
+            case SD_ASYNC_OP_WRITE: result = SD_Async_Do_Write(&req); break;
+            case SD_ASYNC_OP_LIST: result = SD_Async_Do_List(&req); break;
+            case SD_ASYNC_OP_SIZE: result = SD_Async_Do_Size(&req); break;
+            case SD_ASYNC_OP_MKDIR: result = SD_Async_Do_Mkdir(&req); break;
+            case SD_ASYNC_OP_INVALIDATE: SD_Async_Forget(req.path); result = 0; break;
+        }
+        uint32_t dt = micros() - t0;
+        async_stats.requests++;
+        if (dt > async_stats.slowest_us) async_stats.slowest_us = dt;
+        if (req.done) req.done(result, req.user);
+    }
+}
+
+/**
+ * Start the file service. Call once the card is mounted.
+ */
+bool SD_Async_Start(void)
+{
+    if (async_queue) return true;
+    async_data = (uint8_t *)heap_caps_malloc(SD_ASYNC_LINES * SD_ASYNC_LINE, MALLOC_CAP_SPIRAM);
+    async_queue = xQueueCreate(SD_ASYNC_QUEUE, sizeof(SDAsyncRequest));
+    if (!async_data || !async_queue ||
+        xTaskCreatePinnedToCore(SD_Async_Task, "SD Async", 4096, NULL, SD_ASYNC_TASK_PRIORITY, NULL,
+                                SD_ASYNC_TASK_CORE) != pdPASS) {
+        printf("SD async: cannot start\r\n");
+        if (async_queue) vQueueDelete(async_queue);
+        heap_caps_free(async_data);
+        async_queue = NULL;
+        async_data = NULL;
+        return false;
+    }
+    return true;
+}
+
+// Queue a request; false if the service is not running, the path is too long or the queue stayed full
+static bool SD_Async_Submit(SDAsyncRequest *req, const char *path, TickType_t wait)
+{
+    if (!async_queue || !path || strlen(path) >= SD_ASYNC_PATH_LEN) return false;
+    strcpy(req->path, path);
+    if (xQueueSend(async_queue, req, wait) != pdTRUE) return false;
+    uint16_t waiting = uxQueueMessagesWaiting(async_queue);
+    if (waiting > async_stats.queue_peak) async_stats.queue_peak = waiting;
+    return true;
+}
+
+// Requests as the public functions below build them
+static void SD_Async_Read_Req(SDAsyncRequest *req, uint32_t offset, void *buf, uint32_t len)
+{
+    req->op = SD_ASYNC_OP_READ;
+    req->offset = offset;
+    req->len = len;
+    req->buf = buf;
+}
+
+static void SD_Async_Write_Req(SDAsyncRequest *req, uint32_t offset, const void *data, uint32_t len)
+{
+    req->op = SD_ASYNC_OP_WRITE;
+    req->offset = offset;
+    req->len = len;
+    req->buf = (void *)data;
+}
+
+static bool SD_Async_List_Req(SDAsyncRequest *req, const char *filter, char *names, uint16_t name_len, uint16_t max)
+{
+    if (name_len == 0 || (filter && strlen(filter) >= SD_ASYNC_FILTER_LEN)) return false;
+    req->op = SD_ASYNC_OP_LIST;
+    req->name_len = name_len;
+    req->len = max;
+    req->buf = names;
+    strcpy(req->filter, filter ? filter : "");
+    return true;
+}
+
+/**
+ * Read up to len bytes at offset. The result is short at the end of the file.
+ * @param path full path including the mount point
+ * @return false if the request could not be queued; done is not called then
+ */
+bool SD_Async_Read(const char *path, uint32_t offset, void *buf, uint32_t len, SD_Async_cb done, void *user)
+{
+    SDAsyncRequest req = {};
+    SD_Async_Read_Req(&req, offset, buf, len);
+    req.done = done;
+    req.user = user;
+    return SD_Async_Submit(&req, path, 0);
+}
+
+/**
+ * Write len bytes at offset, or at the end with SD_ASYNC_APPEND; creates the file if needed.
+ */
+bool SD_Async_Write(const char *path, uint32_t offset, const void *data, uint32_t len, SD_Async_cb done, void *user)
+{
+    SDAsyncRequest req = {};
+    SD_Async_Write_Req(&req, offset, data, len);
+    req.done = done;
+    req.user = user;
+    return SD_Async_Submit(&req, path, 0);
+}
+
+/**
+ * Names of the files (not directories) in dir that contain filter, in directory order.
+ * @param names    max entries of name_len bytes each
+ * @param filter   substring to match, e.g. ".log"; NULL or "" for all
+ */
+bool SD_Async_List(const char *dir, const char *filter, char *names, uint16_t name_len, uint16_t max,
+                   SD_Async_cb done, void *user)
+{
+    SDAsyncRequest req = {};
+    if (!SD_Async_List_Req(&req, filter, names, name_len, max)) return false;
+    req.done = done;
+    req.user = user;
+    return SD_Async_Submit(&req, dir, 0);
+}
+
+/**
+ * Size of a file in bytes; a negative result means it does not exist.
+ */
+bool SD_Async_Size(const char *path, SD_Async_cb done, void *user)
+{
+    SDAsyncRequest req = {};
+    req.op = SD_ASYNC_OP_SIZE;
+    req.done = done;
+    req.user = user;
+    return SD_Async_Submit(&req, path, 0);
+}
+
+/**
+ * Tell the service that code outside it changed a file. Requests queued after this one
+ * see the new contents. Waits for room in the queue, so it is never lost.
+ * @param path the file, or "" for every file
+ */
+void SD_Async_Invalidate(const char *path)
+{
+    SDAsyncRequest req = {};
+    req.op = SD_ASYNC_OP_INVALIDATE;
+    SD_Async_Submit(&req, path, portMAX_DELAY);
+}
+
+// ------------------ Blocking wrappers ------------------
+
+typedef struct {
+    SemaphoreHandle_t done;
+    int32_t result;
+} SDAsyncWait;
+
+static void SD_Async_Wake(int32_t result, void *user)
+{
+    SDAsyncWait *w = (SDAsyncWait *)user;
+    w->result = result;
+    xSemaphoreGive(w->done);
+}
+
+// Queue a request, waiting for room if needed, and sleep until the file task has served it
+static int32_t SD_Async_Wait(SDAsyncRequest *req, const char *path)
+{
+    StaticSemaphore_t sem;
+    SDAsyncWait w = {xSemaphoreCreateBinaryStatic(&sem), -1};
+    req->done = SD_Async_Wake;
+    req->user = &w;
+    if (SD_Async_Submit(req, path, portMAX_DELAY)) xSemaphoreTake(w.done, portMAX_DELAY);
+    vSemaphoreDelete(w.done);
+    return w.result;
+}
+
+int32_t SD_Async_Read_Wait(const char *path, uint32_t offset, void *buf, uint32_t len)
+{
+    SDAsyncRequest req = {};
+    SD_Async_Read_Req(&req, offset, buf, len);
+    return SD_Async_Wait(&req, path);
+}
+
+int32_t SD_Async_Write_Wait(const char *path, uint32_t offset, const void *data, uint32_t len)
+{
+    SDAsyncRequest req = {};
+    SD_Async_Write_Req(&req, offset, data, len);
+    return SD_Async_Wait(&req, path);
+}
+
+int32_t SD_Async_List_Wait(const char *dir, const char *filter, char *names, uint16_t name_len, uint16_t max)
+{
+    SDAsyncRequest req = {};
+    if (!SD_Async_List_Req(&req, filter, names, name_len, max)) return -1;
+    return SD_Async_Wait(&req, dir);
+}
+
+int32_t SD_Async_Size_Wait(const char *path)
+{
+    SDAsyncRequest req = {};
+    req.op = SD_ASYNC_OP_SIZE;
+    return SD_Async_Wait(&req, path);
+}
+
+/**
+ * Create a directory if it does not exist yet.
+ * @return 0 when the directory exists afterwards, -1 otherwise
+ */
+int32_t SD_Async_Mkdir_Wait(const char *path)
+{
+    SDAsyncRequest req = {};
+    req.op = SD_ASYNC_OP_MKDIR;
+    return SD_Async_Wait(&req, path);
+}
+
+void SD_Async_Get_Stats(SDAsyncStats *out)
+{
+    *out = async_stats;
+}
+
+void SD_Async_Print(void)
+{
+    SDAsyncStats s = async_stats;
+    uint32_t lines = s.hits + s.misses;
+    printf("SD async: %lu requests, cache %lu hits / %lu misses (%.0f%%), %lu large reads, %lu opens, "
+           "slowest %lu us, queue peak %u/%d\r\n",
+           (unsigned long)s.requests, (unsigned long)s.hits, (unsigned long)s.misses,
+           lines ? 100.0f * s.hits / lines : 0.0f, (unsigned long)s.bypass, (unsigned long)s.opens,
+           (unsigned long)s.slowest_us, s.queue_peak, SD_ASYNC_QUEUE);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <Arduino.h>
+
+// File service: one task serves the card for everything but the streaming writers, so the UI
+// (or any task) can queue a read, write, listing or size request and carry on; the request's
+// callback reports the result. The session log (SD_Log_*, with its recovery and benchmark) and
+// black box event files are written beside it for throughput; whoever changes a file that way
+// calls SD_Async_Invalidate on it afterwards. SD_Tune runs at boot, before the service starts. Small reads go through a shared cache of SD_ASYNC_LINE byte lines in
+// PSRAM, so paging back and forth through a file costs one card read per line. Recently used
+// files stay open until the service has been idle for SD_ASYNC_IDLE_MS.
+// Callbacks run in the file task: keep them short, take lvgl_lock() to touch widgets, and
+// never call the _Wait functions from them. Buffers handed to a request must stay valid until
+// its callback has run. A write is on the card (fsync) when its callback runs.
+#define SD_ASYNC_QUEUE          16      // requests waiting at most; submitting to a full queue fails
+#define SD_ASYNC_PATH_LEN       64      // full path including the mount point
+#define SD_ASYNC_FILTER_LEN     16
+#define SD_ASYNC_LINE           4096    // cache line, bytes
+#define SD_ASYNC_LINES          32      // cache lines, 128 KB of PSRAM
+#define SD_ASYNC_BYPASS         (4 * SD_ASYNC_LINE)   // reads this large go straight to the buffer
+#define SD_ASYNC_FILES          4       // files kept open
+#define SD_ASYNC_IDLE_MS        500     // close all files after this long without requests
+#define SD_ASYNC_APPEND         UINT32_MAX            // write offset: at the end of the file
+#define SD_ASYNC_TASK_CORE      0
+#define SD_ASYNC_TASK_PRIORITY  1       // with the SD log tasks, below sensor and UI
+
+// result: bytes read or written, entries listed, or file size; negative on failure
+typedef void (*SD_Async_cb)(int32_t result, void *user);
+
+typedef struct {
+    uint32_t requests;
+    uint32_t hits;          // cache lines served from memory
+    uint32_t misses;        // cache lines read from the card
+    uint32_t bypass;        // large reads that skipped the cache
+    uint32_t opens;         // files opened; low against requests means the open-file cache works
+    uint32_t slowest_us;    // longest single request
+    uint16_t queue_peak;
+} SDAsyncStats;
+
+bool SD_Async_Start(void);
+bool SD_Async_Read(const char *path, uint32_t offset, void *buf, uint32_t len, SD_Async_cb done, void *user);
+bool SD_Async_Write(const char *path, uint32_t offset, const void *data, uint32_t len, SD_Async_cb done, void *user);
+bool SD_Async_List(const char *dir, const char *filter, char *names, uint16_t name_len, uint16_t max,
+                   SD_Async_cb done, void *user);
+bool SD_Async_Size(const char *path, SD_Async_cb done, void *user);
+void SD_Async_Invalidate(const char *path);
+
+// The same requests for callers that can block, e.g. the loop task; -1 if the service is not running
+int32_t SD_Async_Read_Wait(const char *path, uint32_t offset, void *buf, uint32_t len);
+int32_t SD_Async_Write_Wait(const char *path, uint32_t offset, const void *data, uint32_t len);
+int32_t SD_Async_List_Wait(const char *dir, const char *filter, char *names, uint16_t name_len, uint16_t max);
+int32_t SD_Async_Size_Wait(const char *path);
+int32_t SD_Async_Mkdir_Wait(const char *path);
+
+void SD_Async_Get_Stats(SDAsyncStats *out);
+void SD_Async_Print(void);
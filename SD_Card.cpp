@@ -1,9 +1,15 @@
 #include "SD_Card.h"
+#include "SD_Session.h"
+#include "SD_Async.h"
+#include <unistd.h>
+#include <esp_heap_caps.h>
 
 bool SDCard_Flag;
 bool SDCard_Finish;
 
 uint16_t SDCard_Size;
+uint16_t SDCard_Freq_KHz;
+float SDCard_Write_MBps;
 uint16_t Flash_Size;
 
 void SD_D3_Dis(){
@@ -14,14 +20,24 @@ void SD_D3_EN(){
   Set_EXIO(EXIO_PIN4,High);
   vTaskDelay(pdMS_TO_TICKS(10));
 }
+/**
+ * (Re)mount the card at a bus clock, with the configured bus width.
+ * @param freq_khz SD_FREQ_DEFAULT_KHZ, SD_FREQ_HIGHSPEED_KHZ or anything the card accepts in between
+ */
+bool SD_Mount(uint16_t freq_khz) {
+  SD_MMC.end();
+  if (!SD_MMC.begin(SD_MOUNT_POINT, SD_BUS_WIDTH == 1, SD_FORMAT_IF_MOUNT_FAILED, freq_khz)) return false;
+  SDCard_Freq_KHz = freq_khz;
+  return true;
+}
 void SD_Init() {
   // SD MMC
-  if(!SD_MMC.setPins(SD_CLK_PIN, SD_CMD_PIN, SD_D0_PIN,-1,-1,-1)){
+  if(!SD_MMC.setPins(SD_CLK_PIN, SD_CMD_PIN, SD_D0_PIN, SD_D1_PIN, SD_D2_PIN, SD_D3_PIN)){
     printf("SD MMC: Pin change failed!\r\n");
     return;
   }
   SD_D3_EN();
-  if (SD_MMC.begin("/sdcard", true, true)) {                // "/sdcard", true, true     or  "/sdcard", true, false                            
+  if (SD_Mount(SD_FREQ_KHZ ? SD_FREQ_KHZ : SD_FREQ_DEFAULT_KHZ)) {
     printf("SD card initialization successful!\r\n");
   } else {
     printf("SD card initialization failed!\r\n");
@@ -48,61 +64,133 @@ void SD_Init() {
     printf("Total space: %llu\n", totalBytes);
     printf("Used space: %llu\n", usedBytes);
     printf("Free space: %llu\n", totalBytes - usedBytes);
+#if SD_FREQ_KHZ == 0
+    SD_Tune();
+#endif
+    SD_Async_Start();
+    SD_Session_Init();
+  }
+}
+// Test data for block i of the tuning file, different in every word and every block
+static void SD_Tune_Pattern(uint8_t* buf, uint32_t i) {
+  uint32_t* w = (uint32_t *)buf;
+  uint32_t x = 0x9E3779B9u * (i + 1);
+  for (uint32_t k = 0; k < SD_LOG_BLOCK / 4; k++) {
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    w[k] = x;
+  }
+}
+
+// Write SD_TUNE_BYTES at the current clock, read them back and compare
+static bool SD_Tune_Pass(uint8_t* expect, uint8_t* got, float* write_mbps, float* read_mbps) {
+  uint32_t blocks = SD_TUNE_BYTES / SD_LOG_BLOCK;
+  FILE* f = fopen(SD_TUNE_PATH, "wb");
+  if (!f) return false;
+  setvbuf(f, NULL, _IONBF, 0);
+  bool ok = true;
+  uint32_t t0 = micros();
+  for (uint32_t i = 0; i < blocks && ok; i++) {
+    SD_Tune_Pattern(expect, i);
+    ok = fwrite(expect, 1, SD_LOG_BLOCK, f) == SD_LOG_BLOCK;
+  }
+  ok = ok && fsync(fileno(f)) == 0;
+  uint32_t write_us = micros() - t0;
+  fclose(f);
+
+  uint32_t read_us = 0;
+  f = ok ? fopen(SD_TUNE_PATH, "rb") : NULL;
+  if (f) {
+    setvbuf(f, NULL, _IONBF, 0);
+    for (uint32_t i = 0; i < blocks && ok; i++) {
+      t0 = micros();
+      ok = fread(got, 1, SD_LOG_BLOCK, f) == SD_LOG_BLOCK;
+      read_us += micros() - t0;
+      SD_Tune_Pattern(expect, i);
+      ok = ok && memcmp(expect, got, SD_LOG_BLOCK) == 0;
+    }
+    fclose(f);
   }
+  remove(SD_TUNE_PATH);
+  *write_mbps = ok ? (float)SD_TUNE_BYTES / write_us : 0;
+  *read_mbps = ok && read_us ? (float)SD_TUNE_BYTES / read_us : 0;
+  return ok && f;
+}
+
+/**
+ * Startup self-benchmark: remount at each candidate clock, write and verify a scratch file,
+ * and stay on the clock with the best verified write rate. A clock the card or the wiring
+ * cannot hold shows up as a failed mount, an I/O error or a compare mismatch and is skipped.
+ */
+void SD_Tune() {
+  static const uint16_t freqs[] = {SD_FREQ_HIGHSPEED_KHZ, 26000, SD_FREQ_DEFAULT_KHZ};
+  uint8_t* expect = (uint8_t *)heap_caps_aligned_alloc(32, SD_LOG_BLOCK, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  uint8_t* got = (uint8_t *)heap_caps_aligned_alloc(32, SD_LOG_BLOCK, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  if (!expect || !got) {
+    printf("SD tune: out of memory\r\n");
+    heap_caps_free(expect);
+    heap_caps_free(got);
+    return;
+  }
+
+  uint16_t best = 0;
+  float best_mbps = 0;
+  for (uint8_t i = 0; i < sizeof(freqs) / sizeof(freqs[0]); i++) {
+    float w = 0, r = 0;
+    bool ok = SD_Mount(freqs[i]) && SD_Tune_Pass(expect, got, &w, &r);
+    printf("SD tune: %u kHz, %d-bit: %s, write %.2f MB/s, read %.2f MB/s\r\n",
+           freqs[i], SD_BUS_WIDTH, ok ? "verified" : "FAILED", w, r);
+    if (ok && w > best_mbps) {
+      best = freqs[i];
+      best_mbps = w;
+    }
+  }
+  heap_caps_free(expect);
+  heap_caps_free(got);
+
+  if (!best) best = SD_FREQ_DEFAULT_KHZ;
+  if (!SD_Mount(best)) printf("SD tune: remount at %u kHz failed\r\n", best);
+  SDCard_Write_MBps = best_mbps;
+  printf("SD tune: using %u kHz, sequential write %.2f MB/s\r\n", best, best_mbps);
 }
+
+// Full path of name in directory for the file service; the directory itself for an empty name
+static void SD_Join(char* path, size_t len, const char* directory, const char* name)
+{
+  snprintf(path, len, "%s%s%s%s", SD_MOUNT_POINT, strcmp(directory, "/") == 0 ? "" : directory,
+           name[0] ? "/" : "", name);
+}
+
 bool File_Search(const char* directory, const char* fileName)    
 {
-  File Path = SD_MMC.open(directory);
-  if (!Path) {
+  char path[SD_ASYNC_PATH_LEN];
+  SD_Join(path, sizeof(path), directory, "");
+  if (SD_Async_List_Wait(path, NULL, path, 1, 0) < 0) {     // lists nothing, fails if the directory is missing
     printf("Path: <%s> does not exist\r\n",directory);
     return false;
   }
-  File file = Path.openNextFile();
-  while (file) {
-    if (strcmp(file.name(), fileName) == 0) {                           
-      if (strcmp(directory, "/") == 0)
-        printf("File '%s%s' found in root directory.\r\n",directory,fileName);  
-      else
-        printf("File '%s/%s' found in root directory.\r\n",directory,fileName); 
-      Path.close();                                                     
-      return true;                                                     
-    }
-    file = Path.openNextFile();                                        
-  }
+  SD_Join(path, sizeof(path), directory, fileName);
+  bool found = SD_Async_Size_Wait(path) >= 0;
   if (strcmp(directory, "/") == 0)
-    printf("File '%s%s' not found in root directory.\r\n",directory,fileName);           
+    printf("File '%s%s' %s in root directory.\r\n",directory,fileName,found ? "found" : "not found");
   else
-    printf("File '%s/%s' not found in root directory.\r\n",directory,fileName);          
-  Path.close();                                                         
-  return false;                                                         
+    printf("File '%s/%s' %s in root directory.\r\n",directory,fileName,found ? "found" : "not found");
+  return found;                                                         
 }
 uint16_t Folder_retrieval(const char* directory, const char* fileExtension, char File_Name[][100],uint16_t maxFiles)    
 {
-  File Path = SD_MMC.open(directory);
-  if (!Path) {
+  char path[SD_ASYNC_PATH_LEN];
+  SD_Join(path, sizeof(path), directory, "");
+  int32_t fileCount = SD_Async_List_Wait(path, fileExtension, File_Name[0], sizeof(File_Name[0]), maxFiles);
+  if (fileCount < 0) {
     printf("Path: <%s> does not exist\r\n",directory);
-    return false;
+    return 0;
   }
-  
-  uint16_t fileCount = 0;
-  char filePath[100];
-  File file = Path.openNextFile();
-  while (file && fileCount < maxFiles) {
-    if (!file.isDirectory() && strstr(file.name(), fileExtension)) {
-      strncpy(File_Name[fileCount], file.name(), sizeof(File_Name[fileCount])); 
-      if (strcmp(directory, "/") == 0) {                                      
-        snprintf(filePath, 100, "%s%s", directory, file.name());   
-      } else {                                                            
-        snprintf(filePath, 100, "%s/%s", directory, file.name());
-      }
-      printf("File found: %s\r\n", filePath);
-      fileCount++;
-    }
-    file = Path.openNextFile();                                      
+  for (int32_t i = 0; i < fileCount; i++) {
+    SD_Join(path, sizeof(path), directory, File_Name[i]);
+    printf("File found: %s\r\n", path + strlen(SD_MOUNT_POINT));
   }
-  Path.close();                                                         
   if (fileCount > 0) {
-    printf("Retrieved %d mp3 files\r\n",fileCount);
+    printf("Retrieved %d '%s' files\r\n", (int)fileCount, fileExtension);
     return fileCount;                                                 
   } else {
     printf("No files with extension '%s' found in directory: %s\r\n", fileExtension, directory);
@@ -119,4 +207,454 @@ void Flash_test()
   printf("Flash size: %d MB \r\n", flashSize/1024/1024);
 
   printf("/******* RAM Test Over********/\r\n\r\n");
-}
\ No newline at end of file
+}
+
+/*************************************************** SD logging ***************************************************/
+// Producers (any task, any core) claim a 64 byte slot in a bounded lock-free ring and never block:
+// when the ring is full the record is dropped and counted. The writer task packs records back to
+// back into one of two sector-sized DMA blocks; a full block goes to the I/O task, which writes it
+// through the open FILE while the writer fills the other block. A slow card write therefore stalls
+// neither the producers nor the packing, only the ring fills up for a while.
+// Every block starts with a LogBlockHeader (session, sequence, CRC) and is always written whole,
+// so a power cut loses at most the blocks not yet written and SD_Log_Recover finds the end.
+// When the header has LOG_FLAG_PACKED the writer codes each record into the block with Log_Pack
+// instead of copying it; that takes a few microseconds per record and blocks are coded one by one.
+
+typedef struct {
+  volatile uint32_t seq;      // == position when free, position + 1 once the record is in
+  uint16_t len;
+  uint8_t data[SD_LOG_RECORD_MAX];
+} SDLogSlot;
+
+static SDLogSlot *log_ring = NULL;                 // PSRAM; only the indices below need atomics
+static uint32_t log_head = 0;                      // next slot to claim, shared by all producers
+static uint32_t log_tail = 0;                      // next slot to read, writer task only
+static uint8_t *log_block[2] = {NULL, NULL};
+static QueueHandle_t log_full = NULL;              // block index + length, writer -> I/O task
+static QueueHandle_t log_free = NULL;              // block index, I/O task -> writer
+static TaskHandle_t log_writer_task = NULL;
+static TaskHandle_t log_io_task = NULL;
+static FILE *log_file = NULL;
+static uint32_t log_file_len = 0;                  // bytes written to the file, header included
+static uint32_t log_session = 0;
+static uint32_t log_seq = 0;                       // next block's sequence number
+static bool log_packed = false;                    // LOG_FLAG_PACKED: every record is a LogRecord
+static LogPacker log_pack;                         // state of the block being packed, writer task only
+static volatile bool log_running = false;
+static volatile bool log_flush_req = false;
+static SemaphoreHandle_t log_done = NULL;          // given by the I/O task after a flush or stop
+static SDLogStats log_stats;
+
+typedef struct {
+  uint8_t index;
+  bool sync;                                       // flush or stop: fsync and report back
+  bool stop;                                       // last block: close the file afterwards
+  uint16_t len;                                    // SD_LOG_BLOCK, or 0 when there was nothing to write
+} SDLogBlock;
+
+/**
+ * Queue one record for the log. Lock-free and wait-free apart from the slot claim, safe from any
+ * task on either core.
+ * @param data  record bytes, copied
+ * @param len   at most SD_LOG_RECORD_MAX
+ * @return false if logging is not running or the ring is full
+ */
+bool SD_Log_Write(const void* data, uint16_t len)
+{
+  if (!log_running || len == 0 || len > SD_LOG_RECORD_MAX) return false;
+  if (log_packed && len != sizeof(LogRecord)) return false;
+
+  uint32_t pos = __atomic_load_n(&log_head, __ATOMIC_RELAXED);
+  SDLogSlot *slot;
+  while (1) {
+    slot = &log_ring[pos & (SD_LOG_SLOTS - 1)];
+    int32_t dif = (int32_t)(slot->seq - pos);
+    if (dif == 0) {
+      if (__atomic_compare_exchange_n(&log_head, &pos, pos + 1, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        break;                                     // slot is ours; pos was reloaded on failure
+    } else if (dif < 0) {
+      __atomic_add_fetch(&log_stats.dropped, 1, __ATOMIC_RELAXED);
+      return false;                                // writer has not freed this slot yet
+    } else {
+      pos = __atomic_load_n(&log_head, __ATOMIC_RELAXED);
+    }
+  }
+  memcpy(slot->data, data, len);
+  slot->len = len;
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  slot->seq = pos + 1;
+  return true;
+}
+
+// Next record from the ring, or NULL. Writer task only.
+static SDLogSlot* SD_Log_Peek()
+{
+  SDLogSlot *slot = &log_ring[log_tail & (SD_LOG_SLOTS - 1)];
+  if ((int32_t)(slot->seq - (log_tail + 1)) < 0) return NULL;
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  return slot;
+}
+
+static void SD_Log_Release(SDLogSlot* slot)
+{
+  slot->seq = log_tail + SD_LOG_SLOTS;             // free again one lap later
+  log_tail++;
+}
+
+// Pad and seal a block and pass it to the I/O task. A block without records is not written.
+static void SD_Log_Send(uint8_t index, uint16_t fill, bool sync, bool stop)
+{
+  SDLogBlock blk = {index, sync, stop, 0};
+  if (fill > sizeof(LogBlockHeader)) {
+    if (log_packed) fill = sizeof(LogBlockHeader) + Log_Pack_End(&log_pack);
+    memset(log_block[index] + fill, 0, SD_LOG_BLOCK - fill);
+    Log_Block_Seal(log_block[index], log_session, log_seq++, fill - sizeof(LogBlockHeader));
+    blk.len = SD_LOG_BLOCK;
+  }
+  xQueueSend(log_full, &blk, portMAX_DELAY);
+}
+
+// Make block index the current one. Returns the fill level of an empty block.
+static uint16_t SD_Log_Block_Begin(uint8_t index)
+{
+  if (log_packed) Log_Pack_Begin(&log_pack, log_block[index] + sizeof(LogBlockHeader), SD_LOG_BLOCK - sizeof(LogBlockHeader));
+  return sizeof(LogBlockHeader);
+}
+
+// Add one record to the current block, copied or packed. False when it does not fit.
+static bool SD_Log_Append(uint8_t index, uint16_t* fill, const SDLogSlot* slot)
+{
+  if (!log_packed) {
+    if (*fill + slot->len > SD_LOG_BLOCK) return false;
+    memcpy(log_block[index] + *fill, slot->data, slot->len);
+    *fill += slot->len;
+    return true;
+  }
+  uint32_t t0 = micros();
+  bool ok = Log_Pack_Add(&log_pack, (const LogRecord *)slot->data);
+  log_stats.pack_us += micros() - t0;
+  if (ok) *fill = sizeof(LogBlockHeader) + log_pack.pos;   // whole bytes so far, a few bits may still be pending
+  return ok;
+}
+
+// Ring -> blocks. Waits for a free block when both are with the I/O task; the ring takes the slack.
+static void SD_Log_Writer(void *parameter)
+{
+  uint8_t cur;
+  uint16_t fill;
+  uint32_t first_ms = 0;                           // when the first record went into the current block
+  xQueueReceive(log_free, &cur, portMAX_DELAY);
+  fill = SD_Log_Block_Begin(cur);
+
+  while (1) {
+    uint16_t waiting = __atomic_load_n(&log_head, __ATOMIC_RELAXED) - log_tail;
+    if (waiting > log_stats.ring_peak) log_stats.ring_peak = waiting;
+
+    SDLogSlot *slot;
+    while ((slot = SD_Log_Peek()) != NULL) {
+      if (fill == sizeof(LogBlockHeader)) first_ms = millis();
+      if (!SD_Log_Append(cur, &fill, slot)) {      // block full: hand it over, continue in the other
+        SD_Log_Send(cur, fill, false, false);
+        xQueueReceive(log_free, &cur, portMAX_DELAY);
+        fill = SD_Log_Block_Begin(cur);
+        first_ms = millis();
+        SD_Log_Append(cur, &fill, slot);
+      }
+      SD_Log_Release(slot);
+      log_stats.records++;
+    }
+
+    bool stop = !log_running;
+    bool flush = stop || log_flush_req;
+    bool checkpoint = fill > sizeof(LogBlockHeader) && millis() - first_ms >= SD_LOG_CHECKPOINT_MS;
+    if (flush || checkpoint) {                     // ring is drained: pass on the partial block
+      log_flush_req = false;
+      SD_Log_Send(cur, fill, flush, stop);
+      if (stop) break;
+      xQueueReceive(log_free, &cur, portMAX_DELAY);
+      fill = SD_Log_Block_Begin(cur);
+    }
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  log_writer_task = NULL;
+  vTaskDelete(NULL);
+}
+
+// Blocks -> card. The only task that touches the file.
+static void SD_Log_IO(void *parameter)
+{
+  uint32_t last_sync = millis();
+  SDLogBlock blk;
+
+  while (1) {
+    xQueueReceive(log_full, &blk, portMAX_DELAY);
+    if (blk.len) {
+      uint32_t t0 = micros();
+      size_t n = fwrite(log_block[blk.index], 1, blk.len, log_file);
+      uint32_t dt = micros() - t0;
+      if (n != blk.len) printf("SD log: write failed (%u of %u bytes)\r\n", (unsigned)n, blk.len);
+      if (dt > log_stats.write_us_max) log_stats.write_us_max = dt;
+      log_stats.bytes += n;
+      log_file_len += n;
+      log_stats.blocks++;
+    }
+    if (blk.sync || millis() - last_sync >= SD_LOG_SYNC_MS) {
+      fsync(fileno(log_file));
+      last_sync = millis();
+    }
+    if (blk.stop) {
+      if (ftruncate(fileno(log_file), log_file_len) != 0)   // give back the unused preallocation
+        printf("SD log: truncate to %lu bytes failed\r\n", (unsigned long)log_file_len);
+      fclose(log_file);
+      log_file = NULL;
+      xSemaphoreGive(log_done);
+      break;
+    }
+    xQueueSend(log_free, &blk.index, portMAX_DELAY);
+    if (blk.sync) xSemaphoreGive(log_done);
+  }
+  log_io_task = NULL;
+  vTaskDelete(NULL);
+}
+
+/**
+ * Reserve the clusters of a new file up to bytes, then rewind. FATFS extends a file when a
+ * write lands past its end, so this costs one chain allocation now instead of a FAT update
+ * (and the occasional long card stall) every cluster while logging. The reserved area holds
+ * whatever the card had there until it is overwritten.
+ */
+static bool SD_Preallocate(FILE* f, uint32_t bytes)
+{
+  if (bytes == 0) return true;
+  bool ok = fseek(f, bytes - 1, SEEK_SET) == 0 && fputc(0, f) != EOF && fflush(f) == 0 &&
+            fsync(fileno(f)) == 0;
+  return fseek(f, 0, SEEK_SET) == 0 && ok;
+}
+
+/**
+ * Create the log file, reserve its space, write the file header and start the writer and I/O tasks.
+ * An existing file is overwritten. On stop the file is truncated to what was written.
+ * @param path        full path including the mount point
+ * @param header      sealed header; its session tags every block and block_size must be SD_LOG_BLOCK
+ * @param prealloc    bytes to reserve up front, 0 to grow the file as it is written
+ */
+bool SD_Log_Start(const char* path, const LogHeader* header, uint32_t prealloc)
+{
+  if (log_running || log_writer_task || log_io_task) return false;
+  if (SD_MMC.cardType() == CARD_NONE) {
+    printf("SD log: no card\r\n");
+    return false;
+  }
+  if (!Log_Header_Valid(header) || header->block_size != SD_LOG_BLOCK) {
+    printf("SD log: bad header\r\n");
+    return false;
+  }
+
+  if (!log_ring) {
+    log_ring = (SDLogSlot *)heap_caps_malloc(SD_LOG_SLOTS * sizeof(SDLogSlot), MALLOC_CAP_SPIRAM);
+    for (int i = 0; i < 2; i++)
+      log_block[i] = (uint8_t *)heap_caps_aligned_alloc(32, SD_LOG_BLOCK, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    log_full = xQueueCreate(2, sizeof(SDLogBlock));
+    log_free = xQueueCreate(2, sizeof(uint8_t));
+    log_done = xSemaphoreCreateBinary();
+  }
+  if (!log_ring || !log_block[0] || !log_block[1] || !log_full || !log_free || !log_done) {
+    printf("SD log: out of memory\r\n");
+    return false;
+  }
+
+  log_file = fopen(path, "wb");
+  if (!log_file) {
+    printf("SD log: cannot open %s\r\n", path);
+    return false;
+  }
+  setvbuf(log_file, NULL, _IONBF, 0);              // blocks go to FATFS as they are, no extra copy
+  uint32_t t0 = millis();
+  if (!SD_Preallocate(log_file, prealloc))
+    printf("SD log: preallocation failed, the file grows as it is written\r\n");
+  else if (prealloc)
+    printf("SD log: %lu KB reserved in %lu ms\r\n", (unsigned long)(prealloc / 1024), (unsigned long)(millis() - t0));
+  if (fwrite(header, 1, sizeof(LogHeader), log_file) != sizeof(LogHeader)) {
+    printf("SD log: cannot write header to %s\r\n", path);
+    fclose(log_file);
+    log_file = NULL;
+    return false;
+  }
+  log_file_len = sizeof(LogHeader);
+  log_session = header->session;
+  log_seq = 0;
+  log_packed = (header->flags & LOG_FLAG_PACKED) != 0;
+
+  for (uint32_t i = 0; i < SD_LOG_SLOTS; i++) log_ring[i].seq = i;
+  log_head = log_tail = 0;
+  memset(&log_stats, 0, sizeof(log_stats));
+  xQueueReset(log_full);
+  xQueueReset(log_free);
+  xSemaphoreTake(log_done, 0);
+  for (uint8_t i = 0; i < 2; i++) xQueueSend(log_free, &i, 0);
+
+  log_running = true;
+  xTaskCreatePinnedToCore(SD_Log_IO, "SD Log IO", 4096, NULL, SD_LOG_TASK_PRIORITY, &log_io_task, SD_LOG_TASK_CORE);
+  xTaskCreatePinnedToCore(SD_Log_Writer, "SD Log", 3072, NULL, SD_LOG_TASK_PRIORITY, &log_writer_task, SD_LOG_TASK_CORE);
+  printf("SD log: %s\r\n", path);
+  return true;
+}
+
+/**
+ * Write everything queued so far, including a padded partial block, and fsync. Blocks the caller
+ * until the data is on the card.
+ */
+void SD_Log_Flush()
+{
+  if (!log_running) return;
+  log_flush_req = true;
+  xSemaphoreTake(log_done, pdMS_TO_TICKS(2000));
+}
+
+/**
+ * Drain the ring, write the last block and close the file.
+ */
+void SD_Log_Stop()
+{
+  if (!log_running) return;
+  log_running = false;
+  xSemaphoreTake(log_done, pdMS_TO_TICKS(2000));
+}
+
+/**
+ * Count records a producer had to leave out before they reached the ring, so they show up in
+ * the dropped total next to the ones the ring refused.
+ */
+void SD_Log_Drop(uint32_t n)
+{
+  __atomic_add_fetch(&log_stats.dropped, n, __ATOMIC_RELAXED);
+}
+
+void SD_Log_Get_Stats(SDLogStats* out)
+{
+  *out = log_stats;
+}
+
+void SD_Log_Print_Stats()
+{
+  SDLogStats s = log_stats;
+  printf("SD log: %lu records, %lu dropped, %lu blocks, %llu bytes, slowest write %lu us, ring peak %u/%d\r\n",
+         (unsigned long)s.records, (unsigned long)s.dropped, (unsigned long)s.blocks, s.bytes,
+         (unsigned long)s.write_us_max, s.ring_peak, SD_LOG_SLOTS);
+  if (log_packed && s.bytes)
+    printf("SD log: packed %.2fx, %lu us packing per block\r\n",
+           (double)s.records * sizeof(LogRecord) / s.bytes, (unsigned long)(s.blocks ? s.pack_us / s.blocks : 0));
+}
+
+// One benchmark pass: write bytes in SD_LOG_BLOCK chunks to a scratch file and time every write
+static void SD_Log_Bench_Pass(const char* label, uint32_t bytes, bool prealloc, const uint8_t* block)
+{
+  FILE* f = fopen(SD_LOG_BENCH_PATH, "wb");
+  if (!f) {
+    printf("SD bench: cannot create %s\r\n", SD_LOG_BENCH_PATH);
+    return;
+  }
+  setvbuf(f, NULL, _IONBF, 0);
+  uint32_t t0 = millis();
+  SD_Preallocate(f, prealloc ? bytes : 0);
+  uint32_t alloc_ms = millis() - t0;
+
+  uint32_t blocks = bytes / SD_LOG_BLOCK, worst = 0, slow = 0;
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < blocks; i++) {
+    uint32_t t = micros();
+    fwrite(block, 1, SD_LOG_BLOCK, f);
+    uint32_t dt = micros() - t;
+    total += dt;
+    if (dt > worst) worst = dt;
+    if (dt > 10000) slow++;
+  }
+  fclose(f);
+  remove(SD_LOG_BENCH_PATH);
+
+  printf("SD bench %-10s: %lu x %d B, reserve %lu ms, avg %lu us, worst %lu us, %lu writes > 10 ms, %lu KB/s\r\n",
+         label, (unsigned long)blocks, SD_LOG_BLOCK, (unsigned long)alloc_ms,
+         (unsigned long)(blocks ? total / blocks : 0), (unsigned long)worst, (unsigned long)slow,
+         (unsigned long)(total ? (uint64_t)blocks * SD_LOG_BLOCK * 1000 / total : 0));
+}
+
+/**
+ * Compare per-block write latency of a growing file against a preallocated one.
+ * Runs in the calling task and shares the card with a running log, so numbers are best taken
+ * with logging stopped.
+ * @param bytes size of each test file, e.g. SD_LOG_BENCH_BYTES
+ */
+void SD_Log_Benchmark(uint32_t bytes)
+{
+  if (SD_MMC.cardType() == CARD_NONE) {
+    printf("SD bench: no card\r\n");
+    return;
+  }
+  uint8_t* block = (uint8_t *)heap_caps_aligned_alloc(32, SD_LOG_BLOCK, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  if (!block) {
+    printf("SD bench: out of memory\r\n");
+    return;
+  }
+  for (uint32_t i = 0; i < SD_LOG_BLOCK; i++) block[i] = i * 7;
+  SD_Log_Bench_Pass("grow", bytes, false, block);
+  SD_Log_Bench_Pass("prealloc", bytes, true, block);
+  heap_caps_free(block);
+}
+
+// Block i of an open log file checks out against its header
+static bool SD_Log_Block_At(FILE* f, const LogHeader* h, uint8_t* buf, uint32_t i)
+{
+  return fseek(f, sizeof(LogHeader) + i * h->block_size, SEEK_SET) == 0 &&
+         fread(buf, 1, h->block_size, f) == h->block_size &&
+         Log_Block_Valid(buf, h->block_size, h->session, i);
+}
+
+/**
+ * Repair a log file after a power cut. Its directory entry still shows the whole preallocation
+ * (or a stale size), with reserved space or a torn block after the real data. Blocks are
+ * written strictly in order, so the valid ones form a prefix of the file: a closed file ends
+ * on a valid block and is left alone, otherwise a binary search over the block sequence
+ * numbers finds the end in about log2(blocks) reads and the file is truncated there.
+ * @param path full path of the log
+ * @param len  receives the length of the valid part, header included
+ * @return false if the file cannot be opened or has no valid header
+ */
+bool SD_Log_Recover(const char* path, uint32_t* len)
+{
+  FILE* f = fopen(path, "r+b");
+  if (!f) return false;
+  LogHeader h;
+  uint8_t* buf = NULL;
+  if (fread(&h, 1, sizeof(h), f) != sizeof(h) || !Log_Header_Valid(&h) ||
+      !(buf = (uint8_t *)heap_caps_malloc(h.block_size, MALLOC_CAP_DEFAULT))) {
+    printf("SD log: %s has no readable header, not checked\r\n", path);
+    fclose(f);
+    return false;
+  }
+  fseek(f, 0, SEEK_END);
+  uint32_t size = ftell(f);
+  uint32_t blocks = (size - sizeof(LogHeader)) / h.block_size;
+  *len = size;
+
+  uint32_t t0 = millis();
+  if (size != sizeof(LogHeader) + blocks * h.block_size ||
+      (blocks && !SD_Log_Block_At(f, &h, buf, blocks - 1))) {
+    uint32_t lo = 0, hi = blocks;                  // blocks below lo are valid, from hi on are not
+    if (hi && size == sizeof(LogHeader) + blocks * h.block_size) hi--;
+    while (lo < hi) {
+      uint32_t mid = lo + (hi - lo) / 2;
+      if (SD_Log_Block_At(f, &h, buf, mid)) lo = mid + 1;
+      else hi = mid;
+    }
+    *len = sizeof(LogHeader) + lo * h.block_size;
+    fflush(f);
+    if (ftruncate(fileno(f), *len) == 0)
+      printf("SD log: recovered %s, %lu blocks (%lu KB of %lu KB) in %lu ms\r\n", path, (unsigned long)lo,
+             (unsigned long)(*len / 1024), (unsigned long)(size / 1024), (unsigned long)(millis() - t0));
+    else
+      printf("SD log: truncating %s to %lu bytes failed\r\n", path, (unsigned long)*len);
+  }
+  heap_caps_free(buf);
+  fclose(f);
+  return true;
+}
@@ -5,16 +5,72 @@
 #include "SD_MMC.h"
 
 #include "TCA9554PWR.h"
+#include "Log_Format.h"
+#include "Log_Pack.h"
 
 #define SD_CLK_PIN   2
 #define SD_CMD_PIN  1 
 #define SD_D0_PIN  42 
+// This board routes only D0. D3 is held high through EXIO4 to select SD mode, and D1/D2 are
+// not connected, so 4-bit mode needs a board that wires all four data lines to GPIOs.
+#define SD_D1_PIN  -1
+#define SD_D2_PIN  -1
+#define SD_D3_PIN  -1
+
+#define SD_BUS_WIDTH          1       // 1 or 4
+#if SD_BUS_WIDTH == 4 && (SD_D1_PIN < 0 || SD_D2_PIN < 0 || SD_D3_PIN < 0)
+#error "4-bit SDMMC needs SD_D1_PIN, SD_D2_PIN and SD_D3_PIN"
+#endif
+#define SD_FREQ_KHZ           0       // bus clock; 0 picks the fastest clock that passes SD_Tune at boot
+#define SD_FREQ_DEFAULT_KHZ   20000   // default speed, every card
+#define SD_FREQ_HIGHSPEED_KHZ 40000   // high speed mode
+#define SD_FORMAT_IF_MOUNT_FAILED  false   // true wipes a card that merely failed to mount once
+#define SD_TUNE_PATH          SD_MOUNT_POINT "/sdtune.tmp"
+#define SD_TUNE_BYTES         (1024UL * 1024)
+
+#define SD_MOUNT_POINT        "/sdcard"
+#define SD_LOG_BLOCK          16384   // bytes per card write, multiple of the 512 byte sector
+#define SD_LOG_SLOTS          2048    // records the ring can hold, power of two
+#define SD_LOG_RECORD_MAX     58      // payload bytes per record (slot is 64 bytes)
+#define SD_LOG_TASK_PRIORITY  1       // below the sensor and UI tasks
+#define SD_LOG_TASK_CORE      0
+#define SD_LOG_SYNC_MS        1000    // fsync period; with a preallocated file it only refreshes the directory entry
+#define SD_LOG_CHECKPOINT_MS  2000    // a block that has not filled up by then is written padded
+#define SD_LOG_PREALLOC       (64UL * 1024 * 1024)   // clusters reserved at session start, ~70 min at 1 kHz raw, ~4x that packed
+#define SD_LOG_PACK           1       // new sessions are written with LOG_FLAG_PACKED, see Log_Pack.h
+#define SD_LOG_DIVIDER        1       // session log keeps every Nth sample; Black_Box events always keep all
+#define SD_LOG_BENCH_PATH     SD_MOUNT_POINT "/bench.tmp"
+#define SD_LOG_BENCH_BYTES    (8UL * 1024 * 1024)
+
+typedef struct {
+  uint32_t records;       // records taken from the ring
+  uint32_t dropped;       // records refused because the ring was full
+  uint32_t blocks;        // blocks written
+  uint64_t bytes;         // bytes written
+  uint32_t write_us_max;  // slowest block write
+  uint16_t ring_peak;     // most records waiting at once
+  uint32_t pack_us;       // writer time spent packing records, 0 for a raw log
+} SDLogStats;
 
 extern uint16_t SDCard_Size;
+extern uint16_t SDCard_Freq_KHz;
+extern float SDCard_Write_MBps;
 extern uint16_t Flash_Size;
 
 void SD_Init();
+bool SD_Mount(uint16_t freq_khz);
+void SD_Tune();
 void Flash_test();
 
 bool File_Search(const char* directory, const char* fileName);
 uint16_t Folder_retrieval(const char* directory, const char* fileExtension, char File_Name[][100],uint16_t maxFiles);
+
+bool SD_Log_Start(const char* path, const LogHeader* header, uint32_t prealloc);
+bool SD_Log_Write(const void* data, uint16_t len);
+void SD_Log_Drop(uint32_t n);
+void SD_Log_Flush();
+void SD_Log_Stop();
+void SD_Log_Get_Stats(SDLogStats* out);
+void SD_Log_Print_Stats();
+void SD_Log_Benchmark(uint32_t bytes);
+bool SD_Log_Recover(const char* path, uint32_t* len);
@@ -0,0 +1,231 @@
+#include "SD_Session.h"
+#include "SD_Card.h"
+
+static uint32_t session_count = 0;          // entries in the index
+static bool session_open = false;
+static uint32_t session_slot = 0;           // index position of the open session
+static uint32_t session_start_ms = 0;
+static LogIndexEntry session_entry;
+
+/**
+ * Full path of a session's log file.
+ */
+void SD_Session_Path(const LogIndexEntry *e, char *path, size_t len)
+{
+    snprintf(path, len, SD_MOUNT_POINT SD_SESSION_NAME_FMT, (unsigned long)e->number);
+}
+
+// Write entry i of the index, appending when i == session_count
+static bool SD_Session_Put(uint32_t i, LogIndexEntry *e)
+{
+    Log_Index_Seal(e);
+    bool ok = SD_Async_Write_Wait(SD_MOUNT_POINT SD_SESSION_INDEX, i * sizeof(LogIndexEntry), e,
+                                  sizeof(LogIndexEntry)) == sizeof(LogIndexEntry);
+    if (ok && i == session_count) session_count++;
+    return ok;
+}
+
+/**
+ * Read entry i of the index: a 64 byte read, usually from the file service's cache.
+ * @return false if i is out of range or the entry is damaged
+ */
+bool SD_Session_Get(uint32_t i, LogIndexEntry *out)
+{
+    if (i >= session_count) return false;
+    return SD_Async_Read_Wait(SD_MOUNT_POINT SD_SESSION_INDEX, i * sizeof(LogIndexEntry), out,
+                              sizeof(LogIndexEntry)) == sizeof(LogIndexEntry) &&
+           Log_Index_Valid(out);
+}
+
+/**
+ * Queue a read of entries [first, first + n) without blocking, for paging through the
+ * sessions from the UI. done gets the bytes read, from the file task; check every entry
+ * with Log_Index_Valid before use.
+ * @param out n entries, valid until done has run
+ */
+bool SD_Session_Read_Async(uint32_t first, uint32_t n, LogIndexEntry *out, SD_Async_cb done, void *user)
+{
+    if (first >= session_count) return false;
+    if (n > session_count - first) n = session_count - first;
+    return SD_Async_Read(SD_MOUNT_POINT SD_SESSION_INDEX, first * sizeof(LogIndexEntry), out,
+                         n * sizeof(LogIndexEntry), done, user);
+}
+
+uint32_t SD_Session_Count(void)
+{
+    return session_count;
+}
+
+/**
+ * File number of the session being recorded.
+ * @return false when no session is open
+ */
+bool SD_Session_Number(uint32_t *number)
+{
+    if (!session_open) return false;
+    *number = session_entry.number;
+    return true;
+}
+
+/**
+ * Create the sessions directory, size the index, and repair the newest session if it was
+ * never closed (a power cut). Called from SD_Init once the card is mounted.
+ */
+bool SD_Session_Init(void)
+{
+    session_open = false;
+    session_count = 0;
+    if (SD_Async_Mkdir_Wait(SD_MOUNT_POINT SD_SESSION_DIR) != 0) {
+        printf("SD session: cannot create %s\r\n", SD_SESSION_DIR);
+        return false;
+    }
+    int32_t size = SD_Async_Size_Wait(SD_MOUNT_POINT SD_SESSION_INDEX);
+    if (size > 0) session_count = size / sizeof(LogIndexEntry);   // a torn last entry is overwritten
+
+    // The entry is written before the log is created, so an open entry may also have no file,
+    // or one without a header, when the power went in between
+    LogIndexEntry e;
+    if (session_count && SD_Session_Get(session_count - 1, &e) && (e.flags & LOG_INDEX_OPEN)) {
+        char path[48];
+        uint32_t len;
+        SD_Session_Path(&e, path, sizeof(path));
+        if (SD_Log_Recover(path, &len)) {
+            SD_Async_Invalidate(path);                          // truncated behind the service
+            e.bytes = len;
+            e.flags = (e.flags & ~LOG_INDEX_OPEN) | LOG_INDEX_RECOVERED;
+        } else {
+            e.bytes = 0;                                        // nothing was logged
+            e.flags &= ~LOG_INDEX_OPEN;
+        }
+        SD_Session_Put(session_count - 1, &e);
+    }
+    printf("SD session: %lu sessions on card\r\n", (unsigned long)session_count);
+    return true;
+}
+
+/**
+ * Start a new session: next file number, index entry marked open, then the log itself.
+ * The entry comes first, so a power cut can never leave a preallocated log the index does
+ * not know about; SD_Session_Init closes an open entry whatever state its file is in.
+ * @param header sealed log header, see SD_Log_Start
+ */
+bool SD_Session_Begin(const LogHeader *header)
+{
+    if (session_open) SD_Session_End(0, 0, 0);
+
+    LogIndexEntry last;
+    memset(&session_entry, 0, sizeof(session_entry));
+    session_entry.number = session_count && SD_Session_Get(session_count - 1, &last) ? last.number + 1
+                                                                                    : session_count;
+    char path[48];
+    SD_Session_Path(&session_entry, path, sizeof(path));
+    while (SD_Async_Size_Wait(path) >= 0) {                     // only after the index was lost
+        session_entry.number++;
+        SD_Session_Path(&session_entry, path, sizeof(path));
+    }
+
+    session_entry.session = header->session;
+    session_entry.flags = LOG_INDEX_OPEN;
+    if (header->flags & LOG_FLAG_RTC) {
+        session_entry.rtc_valid = 1;
+        session_entry.rtc_year = header->rtc_year;
+        session_entry.rtc_month = header->rtc_month;
+        session_entry.rtc_day = header->rtc_day;
+        session_entry.rtc_hour = header->rtc_hour;
+        session_entry.rtc_minute = header->rtc_minute;
+        session_entry.rtc_second = header->rtc_second;
+    }
+    session_entry.bytes = sizeof(LogHeader);
+
+    session_slot = session_count;
+    if (!SD_Session_Put(session_slot, &session_entry)) {
+        printf("SD session: cannot write %s\r\n", SD_SESSION_INDEX);
+        return false;
+    }
+    if (!SD_Log_Start(path, header, SD_LOG_PREALLOC)) {
+        session_entry.flags &= ~LOG_INDEX_OPEN;                 // keep the number used, with no data
+        session_entry.bytes = 0;
+        SD_Session_Put(session_slot, &session_entry);
+        return false;
+    }
+    session_start_ms = millis();
+    session_open = true;
+    return true;
+}
+
+// Fold the log's progress and the G summary into the open entry and write it back;
+// a mean or p95 of 0 leaves the stored one
+static void SD_Session_Store(uint16_t peak_mg, uint16_t mean_mg, uint16_t p95_mg)
+{
+    SDLogStats s;
+    SD_Log_Get_Stats(&s);
+    session_entry.duration_ms = millis() - session_start_ms;
+    session_entry.bytes = sizeof(LogHeader) + s.blocks * SD_LOG_BLOCK;
+    session_entry.records = s.records;
+    if (peak_mg > session_entry.peak_mg) session_entry.peak_mg = peak_mg;
+    if (mean_mg) session_entry.mean_mg = mean_mg;
+    if (p95_mg) session_entry.p95_mg = p95_mg;
+    SD_Session_Put(session_slot, &session_entry);
+}
+
+/**
+ * Refresh the open session's entry, so a power cut loses at most SD_SESSION_UPDATE_MS of
+ * duration and G summary. Call every SD_SESSION_UPDATE_MS or so.
+ * @param peak_mg highest combined G seen so far; the entry keeps the maximum
+ * @param mean_mg mean combined G of the session so far
+ * @param p95_mg  95th percentile of the combined G of the session so far
+ */
+void SD_Session_Update(uint16_t peak_mg, uint16_t mean_mg, uint16_t p95_mg)
+{
+    if (session_open) SD_Session_Store(peak_mg, mean_mg, p95_mg);
+}
+
+/**
+ * Close the log and mark the session's entry complete with its final G summary,
+ * as for SD_Session_Update.
+ */
+void SD_Session_End(uint16_t peak_mg, uint16_t mean_mg, uint16_t p95_mg)
+{
+    if (!session_open) return;
+    SD_Log_Stop();
+    char path[48];
+    SD_Session_Path(&session_entry, path, sizeof(path));
+    SD_Async_Invalidate(path);                                  // written and truncated by the log
+    session_entry.flags &= ~LOG_INDEX_OPEN;
+    SD_Session_Store(peak_mg, mean_mg, p95_mg);
+    session_open = false;
+}
+
+/**
+ * Print the newest sessions, most recent first.
+ * @param newest how many to list
+ */
+void SD_Session_List(uint32_t newest)
+{
+    printf("Sessions: %lu\r\n", (unsigned long)session_count);
+    for (uint32_t k = 0; k < newest && k < session_count; k++) {
+        uint32_t i = session_count - 1 - k;
+        LogIndexEntry e;
+        if (!SD_Session_Get(i, &e)) {
+            printf("  #%lu damaged\r\n", (unsigned long)i);
+            continue;
+        }
+        SD_Session_Print(&e);
+    }
+}
+
+/**
+ * Print one index entry as a line of SD_Session_List.
+ */
+void SD_Session_Print(const LogIndexEntry *e)
+{
+    char when[32] = "no clock";
+    if (e->rtc_valid)
+        snprintf(when, sizeof(when), "%04u-%02u-%02u %02u:%02u", e->rtc_year, e->rtc_month, e->rtc_day,
+                 e->rtc_hour, e->rtc_minute);
+    printf("  s%05lu  %s  %4lu:%02lu  peak %.2f G  mean %.2f G  p95 %.2f G  %lu KB%s%s\r\n",
+           (unsigned long)e->number, when, (unsigned long)(e->duration_ms / 60000),
+           (unsigned long)(e->duration_ms / 1000 % 60), e->peak_mg / 1000.0f, e->mean_mg / 1000.0f,
+           e->p95_mg / 1000.0f, (unsigned long)(e->bytes / 1024),
+           (e->flags & LOG_INDEX_OPEN) ? "  open" : "", (e->flags & LOG_INDEX_RECOVERED) ? "  recovered" : "");
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <Arduino.h>
+#include "Log_Format.h"
+#include "SD_Async.h"
+
+// One log file per drive session, plus an index with one fixed-size LogIndexEntry per session.
+// Counting, listing and opening sessions read the index at a computed offset, never the directory.
+// Index reads and writes go through the SD_Async file service and its cache.
+#define SD_SESSION_DIR          "/sessions"                    // relative to the mount point
+#define SD_SESSION_NAME_FMT     SD_SESSION_DIR "/s%05lu.log"
+#define SD_SESSION_INDEX        SD_SESSION_DIR "/index.bin"
+#define SD_SESSION_UPDATE_MS    10000   // how often the open session's index entry is refreshed
+
+bool SD_Session_Init(void);
+bool SD_Session_Begin(const LogHeader *header);
+void SD_Session_Update(uint16_t peak_mg, uint16_t mean_mg, uint16_t p95_mg);
+void SD_Session_End(uint16_t peak_mg, uint16_t mean_mg, uint16_t p95_mg);
+uint32_t SD_Session_Count(void);
+bool SD_Session_Number(uint32_t *number);
+bool SD_Session_Get(uint32_t i, LogIndexEntry *out);
+void SD_Session_Path(const LogIndexEntry *e, char *path, size_t len);
+void SD_Session_List(uint32_t newest);
+void SD_Session_Print(const LogIndexEntry *e);
+bool SD_Session_Read_Async(uint32_t first, uint32_t n, LogIndexEntry *out, SD_Async_cb done, void *user);
@@ -0,0 +1,166 @@
+#include "Trail_Canvas.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+#define STAMP_D     (2 * TRAIL_STAMP_R + 1)
+#define SPREAD_MASK 0x07E0F81F          // 0b00000gggggg00000rrrrr000000bbbbb
+
+static lv_obj_t *trail_obj = NULL;
+static uint16_t *trail_buf = NULL;      // RGB565, black = nothing
+static lv_area_t trail_bbox = {0, 0, -1, -1};
+static uint8_t stamp[STAMP_D][STAMP_D]; // stamp intensity, 0..32
+
+static inline uint32_t spread_565(uint16_t c)
+{
+    return (c | ((uint32_t)c << 16)) & SPREAD_MASK;
+}
+
+static inline uint16_t pack_565(uint32_t s)
+{
+    return (uint16_t)(s | (s >> 16));
+}
+
+/**
+ * Per-channel saturating add of two RGB565 pixels. The carry out of each
+ * spread field is turned back into an all-ones field.
+ */
+static inline uint16_t add_565(uint16_t a, uint16_t b)
+{
+    uint32_t sum = spread_565(a) + spread_565(b);
+    uint32_t rb = sum & 0x00010020;             // carries out of b (bit 5) and r (bit 16)
+    uint32_t g = sum & 0x08000000;              // carry out of g (bit 27)
+    sum |= (rb - (rb >> 5)) | (g - (g >> 6));
+    return pack_565(sum & SPREAD_MASK);
+}
+
+static inline bool area_empty(const lv_area_t *a)
+{
+    return a->x1 > a->x2 || a->y1 > a->y2;
+}
+
+/**
+ * Draw hook: add the trail over whatever is already in the draw buffer,
+ * limited to the part of the trail's bounding box being redrawn.
+ */
+static void Trail_Canvas_Draw_cb(lv_event_t *e)
+{
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    lv_area_t area;
+    if (area_empty(&trail_bbox) || !_lv_area_intersect(&area, &trail_bbox, draw_ctx->clip_area))
+        return;
+
+    lv_coord_t buf_w = lv_area_get_width(draw_ctx->buf_area);
+    lv_coord_t w = lv_area_get_width(&area);
+    uint16_t *dest = (uint16_t *)draw_ctx->buf +
+                     (area.y1 - draw_ctx->buf_area->y1) * buf_w + (area.x1 - draw_ctx->buf_area->x1);
+    const uint16_t *src = trail_buf + area.y1 * TRAIL_SIZE + area.x1;
+
+    for (lv_coord_t y = area.y1; y <= area.y2; y++) {
+        for (lv_coord_t x = 0; x < w; x++)
+            if (src[x]) dest[x] = add_565(dest[x], src[x]);
+        dest += buf_w;
+        src += TRAIL_SIZE;
+    }
+}
+
+/**
+ * Create the trail layer: a style-less, non-clickable object the size of the
+ * screen whose only drawing is the additive trail.
+ * @param parent screen to draw on; place the layer with lv_obj_move_to_index
+ */
+void Trail_Canvas_Init(lv_obj_t *parent)
+{
+    trail_buf = (uint16_t *)heap_caps_calloc(TRAIL_SIZE * TRAIL_SIZE, sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+    if (!trail_buf) {
+        printf("Trail: out of PSRAM\r\n");
+        return;
+    }
+
+    for (int y = 0; y < STAMP_D; y++) {
+        for (int x = 0; x < STAMP_D; x++) {
+            float d = sqrtf((x - TRAIL_STAMP_R) * (x - TRAIL_STAMP_R) + (y - TRAIL_STAMP_R) * (y - TRAIL_STAMP_R));
+            float v = 1.0f - d / (TRAIL_STAMP_R + 0.5f);
+            stamp[y][x] = v > 0.0f ? (uint8_t)lroundf(v * 32) : 0;
+        }
+    }
+
+    trail_obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(trail_obj);
+    lv_obj_set_size(trail_obj, TRAIL_SIZE, TRAIL_SIZE);
+    lv_obj_set_align(trail_obj, LV_ALIGN_TOP_LEFT);
+    lv_obj_clear_flag(trail_obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(trail_obj, Trail_Canvas_Draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+}
+
+/**
+ * Stamp a soft point centred on x, y, added to what the trail already holds
+ * so overlapping points get brighter.
+ */
+void Trail_Canvas_Add(lv_coord_t x, lv_coord_t y, lv_color_t color)
+{
+    if (!trail_buf) return;
+    lv_area_t a = {(lv_coord_t)(x - TRAIL_STAMP_R), (lv_coord_t)(y - TRAIL_STAMP_R),
+                   (lv_coord_t)(x + TRAIL_STAMP_R), (lv_coord_t)(y + TRAIL_STAMP_R)};
+    lv_area_t screen = {0, 0, TRAIL_SIZE - 1, TRAIL_SIZE - 1};
+    if (!_lv_area_intersect(&a, &a, &screen)) return;
+
+    uint32_t c = spread_565(color.full);
+    for (lv_coord_t py = a.y1; py <= a.y2; py++) {
+        uint16_t *row = trail_buf + py * TRAIL_SIZE;
+        for (lv_coord_t px = a.x1; px <= a.x2; px++) {
+            uint8_t k = stamp[py - y + TRAIL_STAMP_R][px - x + TRAIL_STAMP_R];
+            if (k) row[px] = add_565(row[px], pack_565(((c * k) >> 5) & SPREAD_MASK));
+        }
+    }
+
+    if (area_empty(&trail_bbox)) trail_bbox = a;
+    else _lv_area_join(&trail_bbox, &trail_bbox, &a);
+    lv_obj_invalidate_area(trail_obj, &a);
+}
+
+/**
+ * Decay every lit pixel by TRAIL_DECAY/32 in one pass over the bounding box,
+ * shrinking the box to what is still lit.
+ * @return true if the trail changed and the frame needs rendering
+ */
+bool Trail_Canvas_Fade(void)
+{
+    if (!trail_buf || area_empty(&trail_bbox)) return false;
+
+    lv_area_t lit = {TRAIL_SIZE, TRAIL_SIZE, -1, -1};
+    for (lv_coord_t y = trail_bbox.y1; y <= trail_bbox.y2; y++) {
+        uint16_t *row = trail_buf + y * TRAIL_SIZE;
+        for (lv_coord_t x = trail_bbox.x1; x <= trail_bbox.x2; x++) {
+            if (!row[x]) continue;
+            uint16_t c = pack_565(((spread_565(row[x]) * TRAIL_DECAY) >> 5) & SPREAD_MASK);
+            row[x] = c;
+            if (!c) continue;
+            lit.x1 = LV_MIN(lit.x1, x);
+            lit.x2 = LV_MAX(lit.x2, x);
+            lit.y1 = LV_MIN(lit.y1, y);
+            lit.y2 = LV_MAX(lit.y2, y);
+        }
+    }
+
+    lv_obj_invalidate_area(trail_obj, &trail_bbox);
+    trail_bbox = lit;
+    return true;
+}
+
+/**
+ * Drop the whole trail.
+ */
+void Trail_Canvas_Clear(void)
+{
+    if (!trail_buf || area_empty(&trail_bbox)) return;
+    lv_obj_invalidate_area(trail_obj, &trail_bbox);
+    for (lv_coord_t y = trail_bbox.y1; y <= trail_bbox.y2; y++)
+        memset(trail_buf + y * TRAIL_SIZE + trail_bbox.x1, 0, lv_area_get_width(&trail_bbox) * sizeof(uint16_t));
+    trail_bbox.x1 = 0;
+    trail_bbox.x2 = -1;
+}
+
+lv_obj_t *Trail_Canvas_Obj(void)
+{
+    return trail_obj;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <lvgl.h>
+
+#define TRAIL_SIZE          480     // trail buffer edge in px, matches the panel
+#define TRAIL_DECAY         26      // per-frame brightness kept, in 1/32: < 1% after 21 frames (700 ms at 30 fps)
+#define TRAIL_STAMP_R       3       // stamp radius in px
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void Trail_Canvas_Init(lv_obj_t *parent);                        // Full-screen layer, additively drawn over what is below it
+void Trail_Canvas_Add(lv_coord_t x, lv_coord_t y, lv_color_t color); // Stamp one soft point
+bool Trail_Canvas_Fade(void);                                    // One decay step; true if anything changed
+void Trail_Canvas_Clear(void);
+lv_obj_t *Trail_Canvas_Obj(void);
+
+#ifdef __cplusplus
+}
+#endif
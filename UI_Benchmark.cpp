@@ -0,0 +1,82 @@
+#include "UI_Benchmark.h"
+#include <esp_heap_caps.h>
+#include "LVGL_Driver.h"
+#include "GForce_Dot.h"
+#include "Trail_Canvas.h"
+
+static uint32_t bench_px = 0;
+
+// In-memory flush: the frame is rendered into LVGL's draw buffers but never sent to the panel
+static void UI_Benchmark_Flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    bench_px += lv_area_get_size(area);
+    lv_disp_flush_ready(drv);
+}
+
+/**
+ * Replay the trace through the G-force update and render every frame with an
+ * in-memory display driver, then print frames/s, invalidated pixels per frame
+ * and heap usage. The frame scheduler is paused for the run and the LVGL lock
+ * is only held per frame, so other tasks are not starved; frames/s counts the
+ * locked update + render time only. Afterwards the trail is cleared and the
+ * scheduler re-applies the latest real sample to the dot and readouts.
+ * tools/ui_bench.cpp replays the same trace headless on a Linux host.
+ * @param update the screen's frame update callback
+ * @param frames number of frames to replay
+ */
+void UI_Benchmark_Run(Frame_Update_cb update, uint32_t frames)
+{
+    lvgl_lock();
+    Frame_Scheduler_Pause(true);
+    lv_disp_t *disp = lv_disp_get_default();
+    void (*flush_cb)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = disp->driver->flush_cb;
+    disp->driver->flush_cb = UI_Benchmark_Flush;
+
+    Trail_Canvas_Clear();
+    GForce_Dot_Reset();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    bench_px = 0;
+    lvgl_unlock();
+
+    size_t heap_before = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+    uint32_t lcg = 1;
+    uint32_t px_max = 0;
+    uint32_t elapsed_us = 0;
+    IMUSample sample;
+
+    for (uint32_t i = 0; i < frames; i++) {
+        lvgl_lock();
+        uint32_t start = micros();
+        uint32_t px_before = bench_px;
+        UI_Benchmark_Sample(i, &lcg, &sample);
+        update(&sample);
+        Frame_Scheduler_Tick(sample.t_us);
+        lv_refr_now(disp);
+        elapsed_us += micros() - start;
+        px_max = max(px_max, bench_px - px_before);
+        lvgl_unlock();
+        vTaskDelay(1);                      // let other tasks waiting on the lock or this core run
+    }
+
+    size_t heap_after = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+    size_t heap_min = heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+
+    lvgl_lock();
+    disp->driver->flush_cb = flush_cb;
+    Trail_Canvas_Clear();
+    GForce_Dot_Reset();
+    lv_obj_invalidate(lv_scr_act());
+    Frame_Scheduler_Pause(false);
+    lvgl_unlock();
+
+    printf("UI benchmark: %lu frames in %lu ms, %.1f frames/s\r\n",
+           frames, elapsed_us / 1000, elapsed_us ? frames * 1000000.0f / elapsed_us : 0.0f);
+    printf("  invalidated px/frame: avg %lu, max %lu\r\n", frames ? bench_px / frames : 0, px_max);
+    printf("  lv_mem used %lu B (peak %lu B, frag %u%%)\r\n",
+           (unsigned long)(mon.total_size - mon.free_size), (unsigned long)mon.max_used, mon.frag_pct);
+    printf("  heap free %u B before, %u B after, %u B minimum ever\r\n",
+           heap_before, heap_after, heap_min);
+}
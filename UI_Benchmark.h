@@ -0,0 +1,8 @@
+#pragma once
+#include <Arduino.h>
+#include "Frame_Scheduler.h"
+
+#define UI_BENCHMARK_FRAMES     600     // 20 s of trace at 30 fps
+
+void UI_Benchmark_Sample(uint32_t i, uint32_t *lcg, IMUSample *s);    // Frame i of the trace; start with *lcg = 1
+void UI_Benchmark_Run(Frame_Update_cb update, uint32_t frames);
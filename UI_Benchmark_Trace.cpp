@@ -0,0 +1,20 @@
+// Benchmark trace of UI_Benchmark, kept free of the display driver so the host
+// benchmark (tools/ui_bench.cpp) replays the same samples.
+#include "UI_Benchmark.h"
+
+/**
+ * Deterministic accelerometer trace: a 1 G circle at 0.5 Hz with a 0.4 G
+ * braking step every 4 s and LCG noise, in g like IMUSample.
+ */
+void UI_Benchmark_Sample(uint32_t i, uint32_t *lcg, IMUSample *s)
+{
+    float t = i / (float)FRAME_TARGET_FPS;
+    *lcg = *lcg * 1664525UL + 1013904223UL;
+    float noise = ((int32_t)(*lcg >> 16) - 32768) / 32768.0f * 0.02f;
+
+    s->seq = i + 1;
+    s->t_us = (uint32_t)(t * 1000000.0f);
+    s->x = sinf(t * PI) + noise;
+    s->y = cosf(t * PI) + noise - (((i / (4 * FRAME_TARGET_FPS)) & 1) ? 0.4f : 0.0f);
+    s->z = 1.0f;
+}
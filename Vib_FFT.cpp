@@ -0,0 +1,107 @@
+#include "Vib_FFT.h"
+#include <math.h>
+
+#if __has_include(<esp_dsp.h>)
+#include <esp_dsp.h>
+#define VIB_FFT_ESP_DSP 1
+#else
+#define VIB_FFT_ESP_DSP 0
+static float twiddle[VIB_FFT_MAX];          // cos, -sin of 2*pi*k/VIB_FFT_MAX for k < VIB_FFT_MAX/2
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * Build the twiddle tables once, for every size up to VIB_FFT_MAX.
+ */
+bool Vib_FFT_Init(void)
+{
+#if VIB_FFT_ESP_DSP
+    return dsps_fft2r_init_fc32(NULL, VIB_FFT_MAX) == ESP_OK;
+#else
+    for (uint16_t k = 0; k < VIB_FFT_MAX / 2; k++) {
+        twiddle[2 * k] = (float)cos(2.0 * M_PI * k / VIB_FFT_MAX);
+        twiddle[2 * k + 1] = (float)-sin(2.0 * M_PI * k / VIB_FFT_MAX);
+    }
+    return true;
+#endif
+}
+
+/**
+ * Complex FFT of n points (power of two, at most VIB_FFT_MAX).
+ * @param data n interleaved re/im pairs, replaced by the spectrum
+ */
+void Vib_FFT_Complex(float *data, uint16_t n)
+{
+#if VIB_FFT_ESP_DSP
+    dsps_fft2r_fc32(data, n);
+    dsps_bit_rev_fc32(data, n);
+#else
+    // bit-reversal permutation
+    for (uint16_t i = 1, j = 0; i < n; i++) {
+        uint16_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j |= bit;
+        if (i < j) {
+            float tr = data[2 * i], ti = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = tr;
+            data[2 * j + 1] = ti;
+        }
+    }
+    // iterative radix-2 butterflies
+    for (uint16_t len = 2; len <= n; len <<= 1) {
+        uint16_t half = len >> 1;
+        uint16_t step = VIB_FFT_MAX / len;
+        for (uint16_t i = 0; i < n; i += len) {
+            for (uint16_t k = 0; k < half; k++) {
+                float wr = twiddle[2 * k * step], wi = twiddle[2 * k * step + 1];
+                float *a = data + 2 * (i + k);
+                float *b = data + 2 * (i + k + half);
+                float tr = b[0] * wr - b[1] * wi;
+                float ti = b[0] * wi + b[1] * wr;
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+#endif
+}
+
+/**
+ * Separate the FFT of a + jb into the magnitude spectra of the real signals a and b.
+ * @param data  output of Vib_FFT_Complex
+ * @param mag_a n/2 bins
+ * @param mag_b n/2 bins
+ */
+void Vib_FFT_Split2(const float *data, uint16_t n, float *mag_a, float *mag_b)
+{
+    for (uint16_t k = 0; k < n / 2; k++) {
+        uint16_t m = (n - k) & (n - 1);
+        float zr = data[2 * k], zi = data[2 * k + 1];
+        float nr = data[2 * m], ni = data[2 * m + 1];
+        float ar = 0.5f * (zr + nr), ai = 0.5f * (zi - ni);     // (Z[k] + conj(Z[n-k])) / 2
+        float br = 0.5f * (zi + ni), bi = -0.5f * (zr - nr);    // (Z[k] - conj(Z[n-k])) / 2j
+        mag_a[k] = sqrtf(ar * ar + ai * ai);
+        mag_b[k] = sqrtf(br * br + bi * bi);
+    }
+}
+
+/**
+ * Periodic Hann window.
+ */
+void Vib_FFT_Hann(float *w, uint16_t n)
+{
+    for (uint16_t i = 0; i < n; i++)
+        w[i] = 0.5f - 0.5f * (float)cos(2.0 * M_PI * i / n);
+}
+
+const char *Vib_FFT_Backend(void)
+{
+    return VIB_FFT_ESP_DSP ? "esp-dsp" : "scalar";
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Radix-2 FFT used by Vib_Spectrum. Uses ESP-DSP when it is available and a
+// portable scalar version otherwise (also built on the host by tools/vib_fft_bench.cpp).
+#define VIB_FFT_MAX     1024    // largest supported block
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool Vib_FFT_Init(void);
+void Vib_FFT_Complex(float *data, uint16_t n);                   // In place, interleaved re/im, natural order out
+void Vib_FFT_Split2(const float *data, uint16_t n, float *mag_a, float *mag_b);  // Spectra of two real signals sent as re/im
+void Vib_FFT_Hann(float *w, uint16_t n);
+const char *Vib_FFT_Backend(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,205 @@
+#include "Vib_Spectrum.h"
+#include <lvgl.h>
+#include "IMU_Sample.h"
+#include "Gyro_QMI8658.h"
+#include "LVGL_Driver.h"
+
+static float window[VIB_FFT_N];
+static float fft_buf[2 * VIB_FFT_N];
+static float mag[VIB_AXES + 1][VIB_FFT_N / 2];      // last block, plus scratch for the unused half of the Z pass
+static float avg[VIB_AXES][VIB_FFT_N / 2];          // averaged amplitude spectra, G
+
+static VibPeak peaks[VIB_AXES][VIB_PEAKS];
+static uint8_t peak_count[VIB_AXES];
+static uint32_t blocks = 0;
+static uint32_t block_us = 0;
+static float sample_hz = 0.0f;
+static portMUX_TYPE vib_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static lv_obj_t *overlay = NULL;
+
+/**
+ * Find the strongest local maxima above VIB_MIN_HZ, refined by fitting a
+ * parabola through each peak bin and its neighbours.
+ */
+static uint8_t Vib_Spectrum_Find_Peaks(const float *spec, VibPeak *out)
+{
+    float bin_hz = sample_hz / VIB_FFT_N;
+    uint16_t k_min = max((uint16_t)2, (uint16_t)(VIB_MIN_HZ / bin_hz + 1));
+    uint8_t n = 0;
+    for (uint16_t k = k_min; k < VIB_FFT_N / 2 - 1; k++) {
+        float a = spec[k - 1], b = spec[k], c = spec[k + 1];
+        if (b <= a || b < c) continue;
+        float den = a - 2.0f * b + c;
+        float d = den != 0.0f ? 0.5f * (a - c) / den : 0.0f;
+        VibPeak p = {(k + d) * bin_hz, b - 0.25f * (a - c) * d};
+
+        // insertion into the top list, strongest first
+        uint8_t i = n < VIB_PEAKS ? n++ : VIB_PEAKS;
+        while (i > 0 && out[i - 1].g < p.g) {
+            if (i < VIB_PEAKS) out[i] = out[i - 1];
+            i--;
+        }
+        if (i < VIB_PEAKS) out[i] = p;
+    }
+    return n;
+}
+
+/**
+ * Spectrum of one block: remove the mean, Hann window, one complex FFT for
+ * X and Y together and one for Z, then average and pick the peaks.
+ */
+static void Vib_Spectrum_Block(const IMURaw *block)
+{
+    uint32_t start = micros();
+    float lsb = QMI8658_Acc_LSB_G();
+    int32_t sum[3] = {0, 0, 0};
+    for (uint16_t i = 0; i < VIB_FFT_N; i++) {
+        sum[0] += block[i].x;
+        sum[1] += block[i].y;
+        sum[2] += block[i].z;
+    }
+    float mean[3] = {(float)sum[0] / VIB_FFT_N, (float)sum[1] / VIB_FFT_N, (float)sum[2] / VIB_FFT_N};
+
+    for (uint16_t i = 0; i < VIB_FFT_N; i++) {
+        fft_buf[2 * i] = (block[i].x - mean[0]) * lsb * window[i];
+        fft_buf[2 * i + 1] = (block[i].y - mean[1]) * lsb * window[i];
+    }
+    Vib_FFT_Complex(fft_buf, VIB_FFT_N);
+    Vib_FFT_Split2(fft_buf, VIB_FFT_N, mag[VIB_X], mag[VIB_Y]);
+
+    for (uint16_t i = 0; i < VIB_FFT_N; i++) {
+        fft_buf[2 * i] = (block[i].z - mean[2]) * lsb * window[i];
+        fft_buf[2 * i + 1] = 0.0f;
+    }
+    Vib_FFT_Complex(fft_buf, VIB_FFT_N);
+    Vib_FFT_Split2(fft_buf, VIB_FFT_N, mag[VIB_Z], mag[VIB_AXES]);
+
+    // Hann has a coherent gain of 1/2: a sine of amplitude A peaks at A * N / 4
+    const float scale = 4.0f / VIB_FFT_N;
+    VibPeak found[VIB_AXES][VIB_PEAKS];
+    uint8_t count[VIB_AXES];
+    for (uint8_t a = 0; a < VIB_AXES; a++) {
+        for (uint16_t k = 0; k < VIB_FFT_N / 2; k++)
+            avg[a][k] += (mag[a][k] * scale - avg[a][k]) * VIB_AVG;
+        count[a] = Vib_Spectrum_Find_Peaks(avg[a], found[a]);
+    }
+
+    portENTER_CRITICAL(&vib_lock);
+    memcpy(peaks, found, sizeof(peaks));
+    memcpy(peak_count, count, sizeof(peak_count));
+    blocks++;
+    block_us = micros() - start;
+    portEXIT_CRITICAL(&vib_lock);
+}
+
+/**
+ * Pull full-rate samples from the IMU ring and analyse blocks with 50%
+ * overlap. Runs below the driver task on the same core, so it only uses
+ * time acquisition leaves free.
+ */
+static void Vib_Spectrum_Task(void *arg)
+{
+    static IMURaw block[VIB_FFT_N];
+    uint32_t cursor = IMU_Ring_Head();
+    uint16_t fill = 0;
+
+    while (1) {
+        fill += IMU_Ring_Read(&cursor, block + fill, VIB_FFT_N - fill);
+        if (fill < VIB_FFT_N) {
+            vTaskDelay(pdMS_TO_TICKS(20));
+            continue;
+        }
+        Vib_Spectrum_Block(block);
+        memmove(block, block + VIB_FFT_N / 2, VIB_FFT_N / 2 * sizeof(IMURaw));
+        fill = VIB_FFT_N / 2;
+    }
+}
+
+static void Vib_Spectrum_Overlay_cb(lv_timer_t *timer)
+{
+    if (lv_obj_has_flag(overlay, LV_OBJ_FLAG_HIDDEN)) return;
+    static const char axes[VIB_AXES] = {'X', 'Y', 'Z'};
+    char text[200];
+    int used = 0;
+    for (uint8_t a = 0; a < VIB_AXES; a++) {
+        VibPeak p[VIB_PEAKS];
+        uint8_t n = Vib_Spectrum_Peaks((VibAxis)a, p);
+        used += snprintf(text + used, sizeof(text) - used, "%c", axes[a]);
+        for (uint8_t i = 0; i < n; i++)
+            used += snprintf(text + used, sizeof(text) - used, "  %.1f Hz %.3f", p[i].hz, p[i].g);
+        used += snprintf(text + used, sizeof(text) - used, "%s", a + 1 < VIB_AXES ? "\n" : "");
+    }
+    lv_label_set_text(overlay, text);
+}
+
+/**
+ * Start the analyser task and create its (hidden) overlay. Call after
+ * QMI8658_FIFO_Init and Lvgl_Init.
+ */
+void Vib_Spectrum_Start(void)
+{
+    sample_hz = QMI8658_Acc_ODR_Hz();
+    Vib_FFT_Init();
+    Vib_FFT_Hann(window, VIB_FFT_N);
+
+    lvgl_lock();
+    overlay = lv_label_create(lv_layer_top());
+    lv_obj_set_style_bg_color(overlay, lv_color_hex(0x000000), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(overlay, LV_OPA_60, LV_PART_MAIN);
+    lv_obj_set_style_text_color(overlay, lv_color_hex(0xFFC800), LV_PART_MAIN);
+    lv_obj_set_style_pad_all(overlay, 4, LV_PART_MAIN);
+    lv_obj_align(overlay, LV_ALIGN_BOTTOM_MID, 0, -60);
+    lv_label_set_text(overlay, "");
+    lv_obj_add_flag(overlay, LV_OBJ_FLAG_HIDDEN);
+    lv_timer_create(Vib_Spectrum_Overlay_cb, VIB_OVERLAY_MS, NULL);
+    lvgl_unlock();
+
+    xTaskCreatePinnedToCore(Vib_Spectrum_Task, "Vib Spectrum", 4096, NULL,
+                            VIB_TASK_PRIORITY, NULL, VIB_TASK_CORE);
+    printf("Vibration spectrum: %u-point %s FFT at %.0f Hz, %.2f Hz bins\r\n",
+           VIB_FFT_N, Vib_FFT_Backend(), sample_hz, sample_hz / VIB_FFT_N);
+}
+
+/**
+ * Dominant frequencies of one axis, strongest first.
+ * @param out VIB_PEAKS entries
+ * @return number of peaks found
+ */
+uint8_t Vib_Spectrum_Peaks(VibAxis axis, VibPeak *out)
+{
+    portENTER_CRITICAL(&vib_lock);
+    uint8_t n = peak_count[axis];
+    memcpy(out, peaks[axis], n * sizeof(VibPeak));
+    portEXIT_CRITICAL(&vib_lock);
+    return n;
+}
+
+void Vib_Spectrum_Print(void)
+{
+    static const char axes[VIB_AXES] = {'X', 'Y', 'Z'};
+    portENTER_CRITICAL(&vib_lock);
+    uint32_t n = blocks, us = block_us;
+    portEXIT_CRITICAL(&vib_lock);
+    printf("Vibration: %lu blocks, %lu us per block\r\n", (unsigned long)n, (unsigned long)us);
+    for (uint8_t a = 0; a < VIB_AXES; a++) {
+        VibPeak p[VIB_PEAKS];
+        uint8_t count = Vib_Spectrum_Peaks((VibAxis)a, p);
+        printf("  %c:", axes[a]);
+        for (uint8_t i = 0; i < count; i++) printf("  %.1f Hz %.3f G", p[i].hz, p[i].g);
+        printf("\r\n");
+    }
+}
+
+void Vib_Spectrum_Toggle_Overlay(void)
+{
+    if (!overlay) return;
+    lvgl_lock();
+    if (lv_obj_has_flag(overlay, LV_OBJ_FLAG_HIDDEN)) {
+        lv_obj_clear_flag(overlay, LV_OBJ_FLAG_HIDDEN);
+        Vib_Spectrum_Overlay_cb(NULL);
+    } else {
+        lv_obj_add_flag(overlay, LV_OBJ_FLAG_HIDDEN);
+    }
+    lvgl_unlock();
+}
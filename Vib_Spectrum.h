@@ -0,0 +1,28 @@
+#pragma once
+#include <Arduino.h>
+#include "Vib_FFT.h"
+
+#define VIB_FFT_N           512     // block length, power of two, 256..VIB_FFT_MAX
+#define VIB_PEAKS           3       // dominant frequencies kept per axis
+#define VIB_MIN_HZ          3.0f    // ignore DC and slow drift
+#define VIB_AVG             0.25f   // weight of each new block in the averaged spectrum
+#define VIB_TASK_CORE       0       // sensor core
+#define VIB_TASK_PRIORITY   1       // below the driver task, so acquisition always wins
+#define VIB_OVERLAY_MS      500     // overlay refresh period
+
+typedef enum {
+    VIB_X = 0,
+    VIB_Y,
+    VIB_Z,
+    VIB_AXES
+} VibAxis;
+
+typedef struct {
+    float hz;               // interpolated peak frequency
+    float g;                // amplitude in G
+} VibPeak;
+
+void Vib_Spectrum_Start(void);
+uint8_t Vib_Spectrum_Peaks(VibAxis axis, VibPeak *out);
+void Vib_Spectrum_Print(void);
+void Vib_Spectrum_Toggle_Overlay(void);
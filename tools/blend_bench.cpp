@@ -0,0 +1,111 @@
+// Host benchmark and self-check of the RGB565+A8 sprite blend used by LVGL_Blend.
+//
+//     c++ -O2 -I. -Itools/host tools/blend_bench.cpp LVGL_Blend_Kernel.cpp -o blend_bench && ./blend_bench
+//
+// Compares the firmware's SWAR kernel (all three channels in one multiply, 5-bit
+// alpha) against a scalar per-channel blend with 8-bit alpha: worst channel
+// error over every alpha, then the time to blend a dot-sized sprite.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include "LVGL_Blend.h"
+
+#define SPRITE      32      // sprite edge in px, about the size of the G-force dot
+#define DEST_W      480     // destination row length, the panel width
+#define ROUNDS      200000
+
+// Scalar reference: each channel mixed separately with 8-bit alpha, rounded
+static void Blend_Scalar(lv_color_t *dest, lv_coord_t dest_stride,
+                         const uint8_t *src, lv_coord_t src_stride,
+                         lv_coord_t w, lv_coord_t h)
+{
+    for (lv_coord_t y = 0; y < h; y++) {
+        uint16_t *d = (uint16_t *)dest;
+        const uint8_t *s = src;
+        for (lv_coord_t x = 0; x < w; x++, s += LV_IMG_PX_SIZE_ALPHA_BYTE) {
+            uint32_t a = s[2];
+            if (a == 0) continue;
+            uint16_t c = (uint16_t)(s[0] | (s[1] << 8));
+            if (a >= LV_OPA_MAX) {
+                d[x] = c;
+                continue;
+            }
+            uint16_t b = d[x];
+            uint32_t r = ((c >> 11) * a + (b >> 11) * (255 - a) + 127) / 255;
+            uint32_t g = (((c >> 5) & 0x3F) * a + ((b >> 5) & 0x3F) * (255 - a) + 127) / 255;
+            uint32_t bl = ((c & 0x1F) * a + (b & 0x1F) * (255 - a) + 127) / 255;
+            d[x] = (uint16_t)((r << 11) | (g << 5) | bl);
+        }
+        dest += dest_stride;
+        src += src_stride * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+}
+
+static int Channel_Error(uint16_t a, uint16_t b)
+{
+    int e = abs((a >> 11) - (b >> 11));
+    e = std::max(e, abs(((a >> 5) & 0x3F) - ((b >> 5) & 0x3F)));
+    return std::max(e, abs((a & 0x1F) - (b & 0x1F)));
+}
+
+// Soft round sprite: opaque centre, alpha falling off over the outer quarter, transparent corners
+static std::vector<uint8_t> Make_Sprite(void)
+{
+    std::vector<uint8_t> px(SPRITE * SPRITE * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    for (int y = 0; y < SPRITE; y++) {
+        for (int x = 0; x < SPRITE; x++) {
+            float r = hypotf(x - (SPRITE - 1) / 2.0f, y - (SPRITE - 1) / 2.0f) / (SPRITE / 2.0f);
+            float a = r < 0.75f ? 1.0f : fmaxf(0.0f, (1.0f - r) * 4.0f);
+            uint16_t c = (uint16_t)(((x * 31 / SPRITE) << 11) | ((y * 63 / SPRITE) << 5) | 0x1F);
+            uint8_t *p = &px[(y * SPRITE + x) * LV_IMG_PX_SIZE_ALPHA_BYTE];
+            p[0] = c & 0xFF;
+            p[1] = c >> 8;
+            p[2] = (uint8_t)lroundf(a * 255);
+        }
+    }
+    return px;
+}
+
+template <typename F>
+static double Time_Blend(F blend, const std::vector<uint8_t> &sprite, std::vector<uint16_t> &dest)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++)
+        blend((lv_color_t *)&dest[(i & 7) * DEST_W + (i & 15)], DEST_W, sprite.data(), SPRITE, SPRITE, SPRITE);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+}
+
+int main()
+{
+    // Worst channel error of one pixel over every alpha, for random colour pairs
+    int worst = 0;
+    srand(1);
+    for (int k = 0; k < 4096; k++) {
+        uint16_t fg = (uint16_t)rand(), bg = (uint16_t)rand();
+        for (int a = 0; a < 256; a++) {
+            uint8_t src[3] = {(uint8_t)(fg & 0xFF), (uint8_t)(fg >> 8), (uint8_t)a};
+            uint16_t swar = bg, scalar = bg;
+            Lvgl_Blend_RGB565A8((lv_color_t *)&swar, 1, src, 1, 1, 1);
+            Blend_Scalar((lv_color_t *)&scalar, 1, src, 1, 1, 1);
+            worst = std::max(worst, Channel_Error(swar, scalar));
+        }
+    }
+    printf("SWAR vs scalar: worst channel error %d LSB\n", worst);
+
+    std::vector<uint8_t> sprite = Make_Sprite();
+    std::vector<uint16_t> dest_swar((SPRITE + 8) * DEST_W), dest_scalar((SPRITE + 8) * DEST_W);
+    for (size_t i = 0; i < dest_swar.size(); i++) dest_swar[i] = dest_scalar[i] = (uint16_t)(i * 2654435761u >> 16);
+
+    double scalar_ns = Time_Blend(Blend_Scalar, sprite, dest_scalar);
+    double swar_ns = Time_Blend(Lvgl_Blend_RGB565A8, sprite, dest_swar);
+    uint32_t sum = 0;
+    for (size_t i = 0; i < dest_swar.size(); i++) sum += dest_swar[i] ^ dest_scalar[i];
+
+    printf("%dx%d sprite: scalar %.0f ns (%.2f ns/px), SWAR %.0f ns (%.2f ns/px), %.2fx (checksum %08x)\n",
+           SPRITE, SPRITE, scalar_ns, scalar_ns / (SPRITE * SPRITE), swar_ns, swar_ns / (SPRITE * SPRITE),
+           swar_ns > 0 ? scalar_ns / swar_ns : 0.0, sum);
+    return 0;
+}
@@ -0,0 +1,205 @@
+// Convert a binary telemetry log (Log_Format.h) to CSV.
+//
+//     c++ -O2 -I. tools/glog_decode.cpp Log_Format.cpp Log_Pack.cpp -o glog_decode
+//     ./glog_decode s00012.log > s00012.csv
+//     ./glog_decode --raw s00012.log > s00012_lsb.csv
+//     ./glog_decode --index index.bin > sessions.csv
+//
+// Columns: t_us (since the start of the log), ax, ay, az in g (calibrated),
+// gx, gy, gz in dps; gyro fields are empty when the log has no gyro.
+// With --raw the sensor values are printed as LSB instead.
+// Decoding stops at the first block that fails its CRC or sequence check, which
+// is where a file that was not closed cleanly (and not yet recovered) ends.
+// --index lists the session index (SD_Session.h) instead, one line per session.
+// The header and throughput go to stderr. Input is read and output is written
+// in large blocks and numbers are formatted without printf.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "Log_Format.h"
+#include "Log_Pack.h"
+
+static const size_t IN_BLOCKS = 64;
+static const size_t OUT_CHUNK = 1 << 20;
+
+struct Out {
+    std::vector<char> buf = std::vector<char>(OUT_CHUNK + 256);
+    size_t n = 0;
+    size_t total = 0;
+
+    void Flush()
+    {
+        fwrite(buf.data(), 1, n, stdout);
+        total += n;
+        n = 0;
+    }
+    void Char(char c) { buf[n++] = c; }
+    void Str(const char *s)
+    {
+        while (*s) buf[n++] = *s++;
+    }
+    void U64(uint64_t v)
+    {
+        char tmp[20];
+        int i = 0;
+        do {
+            tmp[i++] = '0' + v % 10;
+            v /= 10;
+        } while (v);
+        while (i) buf[n++] = tmp[--i];
+    }
+    void I64(int64_t v)
+    {
+        if (v < 0) {
+            Char('-');
+            v = -v;
+        }
+        U64((uint64_t)v);
+    }
+    // Fixed point with five decimals, enough for 16-bit sensor data
+    void Fix5(float f)
+    {
+        int64_t v = llroundf(f * 100000.0f);
+        if (v < 0) {
+            Char('-');
+            v = -v;
+        }
+        U64(v / 100000);
+        Char('.');
+        uint32_t frac = v % 100000;
+        for (uint32_t d = 10000; d; d /= 10) Char('0' + frac / d % 10);
+    }
+    void End()
+    {
+        Char('\n');
+        if (n >= OUT_CHUNK) Flush();
+    }
+};
+
+static void Print_Header(const LogHeader &h)
+{
+    fprintf(stderr, "v%u, session %08x, %.0f Hz, accel %.6g g/LSB, gyro %s, %u byte %s blocks",
+            h.version, h.session, h.odr_hz, h.acc_lsb_g, (h.flags & LOG_FLAG_GYRO) ? "yes" : "no", h.block_size,
+            (h.flags & LOG_FLAG_PACKED) ? "packed" : "raw");
+    if (h.flags & LOG_FLAG_RTC)
+        fprintf(stderr, ", started %04u-%02u-%02u %02u:%02u:%02u",
+                h.rtc_year, h.rtc_month, h.rtc_day, h.rtc_hour, h.rtc_minute, h.rtc_second);
+    if (h.flags & LOG_FLAG_EVENT) {
+        static const char *const reason[] = {"?", "g", "jerk", "manual"};
+        fprintf(stderr, ", %s event at t_us %u", reason[h.trigger <= LOG_TRIGGER_MANUAL ? h.trigger : 0],
+                h.trigger_us - h.start_us);
+    }
+    fprintf(stderr, ", device \"%.*s\"\n", LOG_DEVICE_LEN, h.device);
+}
+
+static int List_Index(FILE *in)
+{
+    printf("number,session,start,duration_s,peak_g,mean_g,p95_g,bytes,records,open,recovered\n");
+    LogIndexEntry e;
+    for (uint32_t i = 0; fread(&e, 1, sizeof(e), in) == sizeof(e); i++) {
+        if (!Log_Index_Valid(&e)) {
+            fprintf(stderr, "entry %u damaged\n", i);
+            continue;
+        }
+        char when[32] = "";
+        if (e.rtc_valid)
+            snprintf(when, sizeof(when), "%04u-%02u-%02uT%02u:%02u:%02u", e.rtc_year, e.rtc_month, e.rtc_day,
+                     e.rtc_hour, e.rtc_minute, e.rtc_second);
+        printf("%u,%08x,%s,%.1f,%.3f,%.3f,%.3f,%u,%u,%d,%d\n", e.number, e.session, when, e.duration_ms / 1000.0,
+               e.peak_mg / 1000.0, e.mean_mg / 1000.0, e.p95_mg / 1000.0, e.bytes, e.records, !!(e.flags & LOG_INDEX_OPEN), !!(e.flags & LOG_INDEX_RECOVERED));
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    bool raw = false, index = false;
+    const char *path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--raw")) raw = true;
+        else if (!strcmp(argv[i], "--index")) index = true;
+        else path = argv[i];
+    }
+    if (!path) {
+        fprintf(stderr, "usage: %s [--raw] file.log > file.csv\n       %s --index index.bin\n", argv[0], argv[0]);
+        return 2;
+    }
+    FILE *in = fopen(path, "rb");
+    if (!in) {
+        perror(path);
+        return 1;
+    }
+    if (index) return List_Index(in);
+
+    auto t0 = std::chrono::steady_clock::now();
+    LogHeader h;
+    if (fread(&h, 1, sizeof(h), in) != sizeof(h) || !Log_Header_Valid(&h) ||
+        h.block_size <= sizeof(LogBlockHeader)) {
+        fprintf(stderr, "%s: not a version %d..%d log\n", path, LOG_VERSION_MIN, LOG_VERSION);
+        return 1;
+    }
+    Print_Header(h);
+
+    std::vector<uint8_t> data(IN_BLOCKS * h.block_size);
+    uint64_t in_total = sizeof(h), records = 0, t_us = 0;
+    uint32_t seq = 0;
+    bool end = false;
+    Out out;
+    out.Str(raw ? "t_us,ax_lsb,ay_lsb,az_lsb,gx_lsb,gy_lsb,gz_lsb\n"
+                : "t_us,ax_g,ay_g,az_g,gx_dps,gy_dps,gz_dps\n");
+
+    while (!end) {
+        size_t got = fread(data.data(), h.block_size, IN_BLOCKS, in);
+        in_total += got * h.block_size;
+        if (got < IN_BLOCKS) end = true;
+
+        for (size_t b = 0; b < got; b++, seq++) {
+            const uint8_t *block = data.data() + b * h.block_size;
+            if (!Log_Block_Valid(block, h.block_size, h.session, seq)) {
+                fprintf(stderr, "end of valid data at block %u\n", seq);
+                end = true;
+                break;
+            }
+            LogUnpacker u;
+            LogRecord r;
+            Log_Unpack_Begin(&u, &h, block);
+            while (Log_Unpack_Next(&u, &r)) {
+                t_us += r.dt_us;
+                records++;
+
+                out.U64(t_us);
+                if (raw) {
+                    for (int i = 0; i < 3; i++) {
+                        out.Char(',');
+                        out.I64(r.accel[i]);
+                    }
+                } else {
+                    float a[3];
+                    Log_Record_Accel_G(&h, &r, a);
+                    for (int i = 0; i < 3; i++) {
+                        out.Char(',');
+                        out.Fix5(a[i]);
+                    }
+                }
+                for (int i = 0; i < 3; i++) {
+                    out.Char(',');
+                    if (!(h.flags & LOG_FLAG_GYRO)) continue;
+                    if (raw) out.I64(r.gyro[i]);
+                    else out.Fix5(r.gyro[i] * h.gyro_lsb_dps);
+                }
+                out.End();
+            }
+        }
+    }
+    out.Flush();
+    fclose(in);
+
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    fprintf(stderr, "%llu records in %u blocks, %.1f MB in, %.1f MB out, %.2f s (%.0f MB/s in)\n",
+            (unsigned long long)records, seq, in_total / 1e6, out.total / 1e6, s, in_total / 1e6 / s);
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Compression ratio and speed of Log_Pack on recorded logs.
+//
+//     c++ -O2 -I. tools/glog_pack_bench.cpp Log_Format.cpp Log_Pack.cpp -o glog_pack_bench
+//     ./glog_pack_bench s00012.log [s00013.log ...]
+//
+// Reads every record of each log (raw or packed), packs them again into blocks of the
+// log's block size exactly as the SD writer does, unpacks the result and checks that
+// every record comes back unchanged. Reports the ratio of raw to packed file size, and
+// pack and unpack speed in MB of raw records per second. A 1 kHz log produces 16 KB/s
+// of raw records; the time the SD writer task actually spends packing on the device
+// is in the serial 'w' statistics.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "Log_Format.h"
+#include "Log_Pack.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static double Since(Clock::time_point t0)
+{
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+static bool Read_Log(const char *path, LogHeader *h, std::vector<LogRecord> *records)
+{
+    FILE *in = fopen(path, "rb");
+    if (!in) {
+        perror(path);
+        return false;
+    }
+    if (fread(h, 1, sizeof(*h), in) != sizeof(*h) || !Log_Header_Valid(h) || h->block_size <= sizeof(LogBlockHeader)) {
+        fprintf(stderr, "%s: not a version %d..%d log\n", path, LOG_VERSION_MIN, LOG_VERSION);
+        fclose(in);
+        return false;
+    }
+    std::vector<uint8_t> block(h->block_size);
+    for (uint32_t seq = 0; fread(block.data(), 1, h->block_size, in) == h->block_size; seq++) {
+        if (!Log_Block_Valid(block.data(), h->block_size, h->session, seq)) break;
+        LogUnpacker u;
+        LogRecord r;
+        Log_Unpack_Begin(&u, h, block.data());
+        while (Log_Unpack_Next(&u, &r)) records->push_back(r);
+    }
+    fclose(in);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s file.log [file.log ...]\n", argv[0]);
+        return 2;
+    }
+    int status = 0;
+    for (int f = 1; f < argc; f++) {
+        LogHeader h;
+        std::vector<LogRecord> records;
+        if (!Read_Log(argv[f], &h, &records)) {
+            status = 1;
+            continue;
+        }
+        size_t n = records.size();
+        uint32_t bs = h.block_size, cap = bs - sizeof(LogBlockHeader);
+        uint32_t per_block = cap / sizeof(LogRecord);
+        uint64_t raw_blocks = (n + per_block - 1) / per_block;
+
+        // pack into whole blocks, as SD_Log_Writer does
+        std::vector<uint8_t> packed((n / 64 + 1) * bs);
+        std::vector<uint32_t> starts;
+        auto t0 = Clock::now();
+        LogPacker p;
+        size_t i = 0;
+        while (i < n) {
+            uint8_t *block = packed.data() + starts.size() * bs;
+            starts.push_back(i);
+            Log_Pack_Begin(&p, block + sizeof(LogBlockHeader), cap);
+            while (i < n && Log_Pack_Add(&p, &records[i])) i++;
+            Log_Block_Seal(block, h.session, starts.size() - 1, Log_Pack_End(&p));
+        }
+        double pack_s = Since(t0);
+
+        // unpack and compare
+        LogHeader ph = h;
+        ph.flags |= LOG_FLAG_PACKED;
+        size_t bad = 0, got = 0;
+        LogRecord r;
+        t0 = Clock::now();
+        for (size_t b = 0; b < starts.size(); b++) {
+            LogUnpacker u;
+            Log_Unpack_Begin(&u, &ph, packed.data() + b * bs);
+            while (Log_Unpack_Next(&u, &r)) bad += memcmp(&r, &records[got++], sizeof(r)) != 0;
+        }
+        double unpack_s = Since(t0);
+        if (got != n) bad += n > got ? n - got : got - n;
+
+        double mb = n * sizeof(LogRecord) / 1e6;
+        double fill = 0;
+        for (size_t b = 0; b < starts.size(); b++)
+            fill += ((const LogBlockHeader *)(packed.data() + b * bs))->payload_len;
+        printf("%s: %zu records, %llu raw blocks -> %zu packed blocks, %.2fx (%.2f bits/record, block fill %.1f%%)\n",
+               argv[f], n, (unsigned long long)raw_blocks, starts.size(), (double)raw_blocks / starts.size(),
+               fill * 8 / n, 100.0 * fill / (starts.size() * (double)cap));
+        printf("  pack %.0f MB/s, unpack %.0f MB/s, %s\n", mb / pack_s, mb / unpack_s,
+               bad ? "MISMATCH" : "round trip ok");
+        if (bad) status = 1;
+    }
+    return status;
+}
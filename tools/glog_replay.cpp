@@ -0,0 +1,171 @@
+// Replay a recorded session through the portable part of the processing chain
+// and time each stage, so throughput numbers come from real drives.
+//
+//     c++ -O2 -I. -Itools/host tools/glog_replay.cpp Log_Format.cpp Log_Pack.cpp Vib_FFT.cpp GG_Envelope.cpp GForce_Stats.cpp -o glog_replay
+//     ./glog_replay s00012.log
+//
+// Stages, in the order the firmware runs them, each through the firmware's own module
+// (tools/host stands in for the Arduino, FreeRTOS and LVGL calls they make):
+//   decode    read and check blocks, unpack records, packed or raw (Log_Format / Log_Pack)
+//   envelope  360-bin G-G maximum (GG_Envelope_Add)
+//   stats     rolling, lap and session moments and histograms (GForce_Stats_Add)
+//   spectrum  512-point blocks with 50% overlap, mean removed, Hann window, averaged
+//             (same framing as Vib_Spectrum, through Vib_FFT)
+// Samples reach envelope and statistics as in the driver task, raw * LSB without calibration.
+// Prints per-stage time per sample on this machine, and what the chain found: the session's
+// combined G from GForce_Stats and the strongest vibration line per axis. The LVGL-bound
+// stages (dot, trail, overlay) and the device's cache and FPU behaviour are not covered, so
+// the total is the host cost of these stages, not the firmware's throughput.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "Log_Format.h"
+#include "Log_Pack.h"
+#include "Vib_FFT.h"
+#include "GG_Envelope.h"
+#include "GForce_Stats.h"
+
+static const uint16_t FFT_N = 512;          // VIB_FFT_N
+static const float AVG = 0.25f;             // VIB_AVG
+static const float MIN_HZ = 3.0f;           // VIB_MIN_HZ
+
+typedef std::chrono::steady_clock Clock;
+
+static double Since(Clock::time_point t0)
+{
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+// Strongest local maximum above MIN_HZ, refined with a parabola through its neighbours
+static float Peak_Hz(const std::vector<float> &spec, float bin_hz, float *amp)
+{
+    uint16_t k_min = std::max(2, (int)(MIN_HZ / bin_hz + 1));
+    float best_hz = 0;
+    *amp = 0;
+    for (uint16_t k = k_min; k < FFT_N / 2 - 1; k++) {
+        float a = spec[k - 1], b = spec[k], c = spec[k + 1];
+        if (b <= a || b < c || b <= *amp) continue;
+        float den = a - 2.0f * b + c;
+        float d = den != 0.0f ? 0.5f * (a - c) / den : 0.0f;
+        best_hz = (k + d) * bin_hz;
+        *amp = b - 0.25f * (a - c) * d;
+    }
+    return best_hz;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s file.log\n", argv[0]);
+        return 2;
+    }
+    FILE *in = fopen(argv[1], "rb");
+    if (!in) {
+        perror(argv[1]);
+        return 1;
+    }
+    LogHeader h;
+    if (fread(&h, 1, sizeof(h), in) != sizeof(h) || !Log_Header_Valid(&h)) {
+        fprintf(stderr, "%s: not a version %d..%d log\n", argv[1], LOG_VERSION_MIN, LOG_VERSION);
+        return 1;
+    }
+
+    // decode
+    auto t0 = Clock::now();
+    std::vector<int16_t> raw;
+    std::vector<uint32_t> t_ms;                 // log time of every sample, for the statistics' seconds
+    std::vector<uint8_t> block(h.block_size);
+    uint64_t log_us = 0;
+    for (uint32_t seq = 0; fread(block.data(), 1, h.block_size, in) == h.block_size; seq++) {
+        if (!Log_Block_Valid(block.data(), h.block_size, h.session, seq)) break;
+        LogUnpacker u;
+        LogRecord r;
+        Log_Unpack_Begin(&u, &h, block.data());
+        while (Log_Unpack_Next(&u, &r)) {
+            log_us += r.dt_us;
+            t_ms.push_back((uint32_t)(log_us / 1000));
+            for (int a = 0; a < 3; a++) raw.push_back(r.accel[a]);
+        }
+    }
+    fclose(in);
+    double decode_s = Since(t0);
+    size_t n = raw.size() / 3;
+    if (n < FFT_N) {
+        fprintf(stderr, "%s: only %zu samples\n", argv[1], n);
+        return 1;
+    }
+
+    // envelope
+    t0 = Clock::now();
+    static GGEnvelope envelope;
+    GG_Envelope_Reset(&envelope);
+    for (size_t i = 0; i < n; i++)
+        GG_Envelope_Add(&envelope, raw[3 * i] * h.acc_lsb_g, raw[3 * i + 1] * h.acc_lsb_g);
+    double envelope_s = Since(t0);
+
+    // statistics, stamped with log time as the firmware does in a replay
+    GStats stats;
+    if (!GForce_Stats_Init(&stats)) return 1;
+    t0 = Clock::now();
+    for (size_t i = 0; i < n; i++)
+        GForce_Stats_Add(&stats, raw[3 * i] * h.acc_lsb_g, raw[3 * i + 1] * h.acc_lsb_g, t_ms[i]);
+    double stats_s = Since(t0);
+
+    // spectrum
+    Vib_FFT_Init();
+    t0 = Clock::now();
+    std::vector<float> window(FFT_N), z(2 * FFT_N), scratch(FFT_N / 2);
+    std::vector<std::vector<float>> mag(3, std::vector<float>(FFT_N / 2)), avg(3, std::vector<float>(FFT_N / 2, 0.0f));
+    Vib_FFT_Hann(window.data(), FFT_N);
+    uint32_t blocks = 0;
+    for (size_t start = 0; start + FFT_N <= n; start += FFT_N / 2, blocks++) {
+        const int16_t *b = &raw[3 * start];
+        float mean[3] = {0, 0, 0};
+        for (uint16_t i = 0; i < FFT_N; i++)
+            for (int a = 0; a < 3; a++) mean[a] += b[3 * i + a];
+        for (int a = 0; a < 3; a++) mean[a] /= FFT_N;
+
+        for (uint16_t i = 0; i < FFT_N; i++) {
+            z[2 * i] = (b[3 * i] - mean[0]) * h.acc_lsb_g * window[i];
+            z[2 * i + 1] = (b[3 * i + 1] - mean[1]) * h.acc_lsb_g * window[i];
+        }
+        Vib_FFT_Complex(z.data(), FFT_N);
+        Vib_FFT_Split2(z.data(), FFT_N, mag[0].data(), mag[1].data());
+        for (uint16_t i = 0; i < FFT_N; i++) {
+            z[2 * i] = (b[3 * i + 2] - mean[2]) * h.acc_lsb_g * window[i];
+            z[2 * i + 1] = 0.0f;
+        }
+        Vib_FFT_Complex(z.data(), FFT_N);
+        Vib_FFT_Split2(z.data(), FFT_N, mag[2].data(), scratch.data());
+
+        const float scale = 4.0f / FFT_N;
+        for (int a = 0; a < 3; a++)
+            for (uint16_t k = 0; k < FFT_N / 2; k++) avg[a][k] += (mag[a][k] * scale - avg[a][k]) * AVG;
+    }
+    double spectrum_s = Since(t0);
+
+    double total_s = decode_s + envelope_s + stats_s + spectrum_s;
+    printf("%s: %zu samples, %.1f s of log at %.0f Hz\n", argv[1], n, log_us / 1e6, h.odr_hz);
+    printf("  decode    %7.1f ns/sample\n", decode_s * 1e9 / n);
+    printf("  envelope  %7.1f ns/sample\n", envelope_s * 1e9 / n);
+    printf("  stats     %7.1f ns/sample\n", stats_s * 1e9 / n);
+    printf("  spectrum  %7.1f ns/sample  (%u blocks, %.1f us/block, %s)\n", spectrum_s * 1e9 / n, blocks,
+           spectrum_s * 1e6 / blocks, Vib_FFT_Backend());
+    printf("  total     %7.1f ns/sample on this host\n", total_s * 1e9 / n);
+    GStatSummary g;
+    if (GForce_Stats_Get(&stats, GSTATS_SESSION, GSTATS_COMBINED, &g))
+        printf("Combined G: peak %.2f, mean %.3f, rms %.3f, p95 %.2f\n", g.max, g.mean, g.rms, g.p95);
+    uint16_t seen = 0;
+    for (uint16_t b = 0; b < GG_ENVELOPE_BINS; b++) seen += envelope.max_mg[b] != 0;
+    printf("Envelope: %u of %d directions seen\n", seen, GG_ENVELOPE_BINS);
+    const char *axis = "XYZ";
+    for (int a = 0; a < 3; a++) {
+        float amp;
+        float hz = Peak_Hz(avg[a], h.odr_hz / FFT_N, &amp);
+        printf("Vibration %c: %.1f Hz, %.4f G\n", axis[a], hz, amp);
+    }
+    return 0;
+}
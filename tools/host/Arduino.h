@@ -0,0 +1,49 @@
+// Host stand-in for the few Arduino and FreeRTOS calls the portable firmware modules make,
+// so tools can build GG_Envelope, GForce_Stats and the G-force screen modules unchanged.
+// Not a general Arduino shim.
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+using std::max;
+using std::min;
+
+#define IRAM_ATTR
+#define PI 3.1415926535897932384626433832795
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+static inline uint32_t millis(void)
+{
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static inline uint32_t micros(void)
+{
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Cycle counter as nanoseconds, for the firmware's own on-target benchmarks
+[[maybe_unused]] static struct {
+    uint32_t getCycleCount(void)
+    {
+        using namespace std::chrono;
+        return (uint32_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+} ESP;
+
+// Mutexes as std::mutex, which is what the firmware's uncontended FreeRTOS mutex costs most like
+typedef std::mutex *SemaphoreHandle_t;
+typedef int BaseType_t;
+#define pdTRUE 1
+#define portMAX_DELAY 0xFFFFFFFFu
+static inline SemaphoreHandle_t xSemaphoreCreateMutex(void) { return new std::mutex; }
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t m, uint32_t) { m->lock(); return pdTRUE; }
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t m) { m->unlock(); return pdTRUE; }
+static inline void vSemaphoreDelete(SemaphoreHandle_t m) { delete m; }
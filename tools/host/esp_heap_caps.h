@@ -0,0 +1,11 @@
+// Host stand-in: every capability is plain heap
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_SPIRAM   0
+#define MALLOC_CAP_INTERNAL 0
+
+static inline void *heap_caps_malloc(size_t size, uint32_t) { return malloc(size); }
+static inline void *heap_caps_calloc(size_t n, size_t size, uint32_t) { return calloc(n, size); }
+static inline void heap_caps_free(void *p) { free(p); }
@@ -0,0 +1,35 @@
+// Host stand-in for the LVGL types and calls GG_Envelope's overlay and LVGL_Blend's kernel use.
+// The overlay is never created on the host; these only let the modules link.
+#pragma once
+#include <stdint.h>
+
+typedef int16_t lv_coord_t;
+typedef struct { lv_coord_t x, y; } lv_point_t;
+typedef struct { lv_coord_t x1, y1, x2, y2; } lv_area_t;
+typedef struct { uint16_t full; } lv_color_t;
+typedef struct _lv_obj_t lv_obj_t;
+typedef uint8_t lv_opa_t;
+typedef struct _lv_disp_drv_t lv_disp_drv_t;
+typedef struct _lv_draw_ctx_t lv_draw_ctx_t;
+
+#define LV_COLOR_DEPTH              16
+#define LV_COLOR_16_SWAP            0
+#define LV_IMG_PX_SIZE_ALPHA_BYTE   3
+#define LV_OPA_MAX                  253
+
+#define LV_OBJ_FLAG_CLICKABLE   (1 << 1)
+#define LV_OBJ_FLAG_SCROLLABLE  (1 << 4)
+#define LV_PART_MAIN            0
+#define LV_STATE_DEFAULT        0
+#define LV_OPA_70               178
+
+static inline lv_obj_t *lv_line_create(lv_obj_t *) { return nullptr; }
+static inline void lv_line_set_points(lv_obj_t *, const lv_point_t *, uint16_t) {}
+static inline void lv_obj_set_pos(lv_obj_t *, lv_coord_t, lv_coord_t) {}
+static inline void lv_obj_set_size(lv_obj_t *, lv_coord_t, lv_coord_t) {}
+static inline void lv_obj_clear_flag(lv_obj_t *, uint32_t) {}
+static inline lv_color_t lv_color_hex(uint32_t c) { return lv_color_t{(uint16_t)c}; }
+static inline void lv_obj_set_style_line_color(lv_obj_t *, lv_color_t, uint32_t) {}
+static inline void lv_obj_set_style_line_width(lv_obj_t *, lv_coord_t, uint32_t) {}
+static inline void lv_obj_set_style_line_rounded(lv_obj_t *, bool, uint32_t) {}
+static inline void lv_obj_set_style_line_opa(lv_obj_t *, lv_opa_t, uint32_t) {}
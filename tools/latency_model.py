@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""Simulate the motion-to-photon pipeline and print the same p50/p99 table as
+Latency_Trace_Report() on the target.
+
+    tools/latency_model.py
+    tools/latency_model.py --sample-ms 10 --fps 60
+
+Each stage is timed from the sample's capture, as on the target:
+    publish   capture + sensor/battery read
+    update    next frame scheduler tick that finds this sample still the latest
+    flush     update + LVGL render and flush of the frame
+    vsync     first panel vsync after the flush
+    scanout   vsync + time for the scan to reach --row (not measured on target)
+Samples replaced by a newer one before any frame picks them up are never
+shown and are counted separately.
+"""
+
+import argparse
+import random
+
+# ST7701 RGB timings from Display_ST7701.cpp
+PCLK_HZ = 16000000
+H_TOTAL = 480 + 10 + 20 + 10
+V_TOTAL = 480 + 10 + 20 + 10
+V_BLANK = 10 + 20                       # pulse + back porch before the first visible line
+
+STAGES = ["publish", "update", "flush", "vsync", "scanout"]
+
+
+def percentile(values, pct):
+    values = sorted(values)
+    return values[min(len(values) - 1, max(0, (len(values) * pct + 99) // 100 - 1))]
+
+
+def simulate(args):
+    rnd = random.Random(args.seed)
+    sample_period = args.sample_ms + args.read_ms
+    frame_period = 1000.0 / args.fps
+    refresh = H_TOTAL * V_TOTAL * 1000.0 / PCLK_HZ
+    line = refresh / V_TOTAL
+
+    frame_phase = rnd.uniform(0, frame_period)
+    vsync_phase = rnd.uniform(0, refresh)
+    traces = []
+    replaced = 0
+
+    for i in range(args.samples):
+        capture = i * sample_period + rnd.uniform(0, args.jitter_ms)
+        publish = capture + args.read_ms
+        next_publish = (i + 1) * sample_period + args.read_ms
+        # first frame tick at or after publish
+        k = max(0, -(-(publish - frame_phase) // frame_period))
+        tick = frame_phase + k * frame_period
+        if tick >= next_publish:
+            replaced += 1
+            continue
+        update = tick + args.update_ms
+        flush = update + max(0.0, rnd.gauss(args.render_ms, args.render_sd_ms))
+        n = max(0, -(-(flush - vsync_phase) // refresh))
+        vsync = vsync_phase + n * refresh
+        scanout = vsync + (V_BLANK + args.row) * line
+        traces.append([t - capture for t in (publish, update, flush, vsync, scanout)])
+    return traces, replaced, refresh
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("--samples", type=int, default=100000, help="samples to simulate")
+    ap.add_argument("--sample-ms", type=float, default=50.0, help="Driver_Loop delay between reads")
+    ap.add_argument("--read-ms", type=float, default=1.5, help="IMU + battery read time")
+    ap.add_argument("--jitter-ms", type=float, default=1.0, help="scheduling jitter of the driver task")
+    ap.add_argument("--fps", type=float, default=30.0, help="FRAME_TARGET_FPS")
+    ap.add_argument("--update-ms", type=float, default=0.3, help="widget update stage")
+    ap.add_argument("--render-ms", type=float, default=12.0, help="mean LVGL render + flush")
+    ap.add_argument("--render-sd-ms", type=float, default=3.0, help="render + flush standard deviation")
+    ap.add_argument("--row", type=int, default=240, help="panel row of interest for the scanout stage")
+    ap.add_argument("--seed", type=int, default=1)
+    args = ap.parse_args()
+
+    traces, replaced, refresh = simulate(args)
+    print("Model: %.1f ms samples, %.0f fps, %.2f ms panel refresh" %
+          (args.sample_ms + args.read_ms, args.fps, refresh))
+    print("Latency from capture: %d samples traced, %d replaced in flight" % (len(traces), replaced))
+    if not traces:
+        return
+    for s, name in enumerate(STAGES):
+        col = [t[s] for t in traces]
+        print("  %-8s p50 %6.1f ms  p99 %6.1f ms" % (name, percentile(col, 50), percentile(col, 99)))
+
+
+if __name__ == "__main__":
+    main()
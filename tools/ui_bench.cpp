@@ -0,0 +1,101 @@
+// Headless host benchmark of the G-force screen: the SquareLine `ui` library and the firmware's
+// screen modules (GForce_Screen, Gauge_Face, GForce_Dot, Trail_Canvas, GG_Envelope overlay,
+// NumLabel readouts, LVGL_Blend draw context) against LVGL 8.3 with an in-memory display.
+// Built by tools/ui_host/CMakeLists.txt:
+//
+//     cmake -S tools/ui_host -B build_ui_host && cmake --build build_ui_host -j && build_ui_host/ui_bench [frames]
+//
+// Replays UI_Benchmark's deterministic trace, one sample per frame, and prints the same
+// figures as the on-target 'b' command: frames/s, invalidated px/frame and heap. The trace
+// also feeds the envelope overlay, which on the target shows the live session instead.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/resource.h>
+#include <lvgl.h>
+#include "ui.h"
+#include "LVGL_Blend.h"
+#include "GForce_Screen.h"
+#include "UI_Benchmark.h"
+
+#define HOST_BUF_LINES  40      // draw buffer height, as Lvgl_Init uses on the target
+
+static uint64_t bench_px = 0;
+
+// In-memory flush: the frame is rendered into LVGL's draw buffers and dropped
+static void Host_Flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    (void)color_p;
+    bench_px += lv_area_get_size(area);
+    lv_disp_flush_ready(drv);
+}
+
+static void Host_Display_Init(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t disp_drv;
+    static lv_color_t buf1[480 * HOST_BUF_LINES], buf2[480 * HOST_BUF_LINES];
+
+    lv_disp_draw_buf_init(&draw_buf, buf1, buf2, 480 * HOST_BUF_LINES);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = 480;
+    disp_drv.ver_res = 480;
+    disp_drv.flush_cb = Host_Flush;
+    disp_drv.draw_ctx_init = Lvgl_Blend_Ctx_Init;   // the firmware's renderer, sprite fast path included
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&disp_drv);
+
+    lv_obj_t *scr = lv_disp_get_scr_act(lv_disp_get_default());
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x000000), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, LV_PART_MAIN);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t frames = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : UI_BENCHMARK_FRAMES;
+
+    lv_init();
+    Host_Display_Init();
+    ui_init();
+    GForce_Screen_Init();
+
+    static GGEnvelope envelope;
+    GG_Envelope_Reset(&envelope);
+
+    lv_disp_t *disp = lv_disp_get_default();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    bench_px = 0;
+
+    uint32_t lcg = 1;
+    uint64_t px_max = 0;
+    double elapsed_us = 0;
+    IMUSample sample;
+
+    for (uint32_t i = 0; i < frames; i++) {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t px_before = bench_px;
+        UI_Benchmark_Sample(i, &lcg, &sample);
+        GG_Envelope_Add(&envelope, sample.x, sample.y);
+        GForce_Screen_Update(&sample);
+        GForce_Screen_Tick(sample.t_us, &envelope);
+        lv_refr_now(disp);
+        elapsed_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (bench_px - px_before > px_max) px_max = bench_px - px_before;
+    }
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    printf("UI benchmark (host): %u frames in %.0f ms, %.1f frames/s\n",
+           frames, elapsed_us / 1000, elapsed_us > 0 ? frames * 1000000.0 / elapsed_us : 0.0);
+    printf("  invalidated px/frame: avg %llu, max %llu\n",
+           (unsigned long long)(frames ? bench_px / frames : 0), (unsigned long long)px_max);
+    printf("  lv_mem used %lu B (peak %lu B, frag %u%%)\n",
+           (unsigned long)(mon.total_size - mon.free_size), (unsigned long)mon.max_used, mon.frag_pct);
+    printf("  max resident set %ld kB\n", usage.ru_maxrss);
+    return 0;
+}
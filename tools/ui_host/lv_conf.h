@@ -0,0 +1,28 @@
+// LVGL 8.3 configuration of the headless host build (tools/ui_host). Only what differs from
+// LVGL's defaults or what the G-force screen relies on; the colour format must match the
+// firmware and SquareLine's settings (ui.c checks it).
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#include <stdint.h>
+
+#define LV_COLOR_DEPTH          16
+#define LV_COLOR_16_SWAP        0
+
+#define LV_MEM_CUSTOM           0
+#define LV_MEM_SIZE             (64U * 1024U)
+
+#define LV_TICK_CUSTOM          0      // frames are rendered with lv_refr_now(), no timers run
+#define LV_DPI_DEF              130
+
+#define LV_USE_LOG              0
+#define LV_USE_PERF_MONITOR     0
+#define LV_USE_MEM_MONITOR      0
+
+#define LV_FONT_MONTSERRAT_14   1      // LV_FONT_DEFAULT, used for the gauge face ring values
+#define LV_FONT_MONTSERRAT_32   1      // G readouts
+#define LV_FONT_DEFAULT         &lv_font_montserrat_14
+
+#define LV_BUILD_EXAMPLES       0
+
+#endif
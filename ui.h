@@ -37,7 +37,6 @@ extern "C" {
 extern lv_obj_t * ui____initial_actions0;
 
 // IMAGES AND IMAGE SETS
-LV_IMG_DECLARE(ui_img_gforcegauge_asset_1_png);    // assets/GforceGauge Asset 1.png
 LV_IMG_DECLARE(ui_img_dot_asset_2_png);    // assets/Dot Asset 2.png
 
 // UI INIT
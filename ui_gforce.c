@@ -21,10 +21,9 @@ void ui_gforce_screen_init(void)
     ui_gforce = lv_obj_create(NULL);
     lv_obj_clear_flag(ui_gforce, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
 
-    ui_bgGauge = lv_img_create(ui_gforce);
-    lv_img_set_src(ui_bgGauge, &ui_img_gforcegauge_asset_1_png);
-    lv_obj_set_width(ui_bgGauge, LV_SIZE_CONTENT);   /// 520
-    lv_obj_set_height(ui_bgGauge, LV_SIZE_CONTENT);    /// 520
+    ui_bgGauge = lv_canvas_create(ui_gforce);    /// face is drawn by Gauge_Face_Init()
+    lv_obj_set_width(ui_bgGauge, LV_SIZE_CONTENT);   /// 480
+    lv_obj_set_height(ui_bgGauge, LV_SIZE_CONTENT);    /// 480
     lv_obj_set_align(ui_bgGauge, LV_ALIGN_CENTER);
     lv_obj_add_flag(ui_bgGauge, LV_OBJ_FLAG_ADV_HITTEST);     /// Flags
     lv_obj_clear_flag(ui_bgGauge, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
@@ -1,47 +0,0 @@
-// This file was generated by SquareLine Studio
-// SquareLine Studio version: SquareLine Studio 1.5.4
-// LVGL version: 8.3.11
-// Project name: SquareLine_Project
-
-#include "ui.h"
-
-#ifndef LV_ATTRIBUTE_MEM_ALIGN
-    #define LV_ATTRIBUTE_MEM_ALIGN
-#endif
-
-// IMAGE DATA: assets/Dot Asset 2.png
-const LV_ATTRIBUTE_MEM_ALIGN uint8_t ui_img_dot_asset_2_png_data[] = {
-    0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x02,0xE0,0xFF,0x04,0xE0,0xFF,0x05,0xE0,0xFF,0x05,0xE0,0xFF,0x04,0xE0,0xFF,0x02,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x01,0xE0,0xFF,0x06,0xE0,0xFF,0x0A,0xE0,0xFF,0x0E,0xE0,0xFF,0x10,0xE0,0xFF,0x12,0xE0,0xFF,0x13,0xE0,0xFF,0x13,0xE0,0xFF,0x12,0xE0,0xFF,0x10,0xE0,0xFF,0x0E,0xE0,0xFF,0x0A,0xE0,0xFF,0x06,0xE0,0xFF,0x01,0xFF,0xFF,0x00,
-    0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x01,0xE0,0xFF,0x08,0xE0,0xFF,0x0E,0xE0,0xFF,0x13,0xE0,0xFF,0x19,0xE0,0xFF,0x1C,0xE0,0xFF,0x1F,0xE0,0xFF,0x21,0xE0,0xFF,0x22,0xE0,0xFF,0x22,0xE0,0xFF,0x21,0xE0,0xFF,0x1F,0xE0,0xFF,0x1C,0xE0,0xFF,0x19,0xE0,0xFF,0x13,0xE0,0xFF,0x0E,0xE0,0xFF,0x08,0xE0,0xFF,0x01,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x06,0xE0,0xFF,0x0D,0xE0,0xFF,0x15,0xE0,0xFF,0x1C,0xE0,0xFF,0x22,0xE0,0xFF,0x26,0xE0,0xFF,0x2A,0xE0,0xFF,0x2D,
-    0xE0,0xFF,0x2F,0xE0,0xFF,0x30,0xE0,0xFF,0x30,0xE0,0xFF,0x2F,0xE0,0xFF,0x2D,0xE0,0xFF,0x2A,0xE0,0xFF,0x26,0xE0,0xFF,0x22,0xE0,0xFF,0x1C,0xE0,0xFF,0x15,0xE0,0xFF,0x0E,0xE0,0xFF,0x06,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x09,0xE0,0xFF,0x11,0xE0,0xFF,0x1A,0xE0,0xFF,0x22,0xE0,0xFF,0x29,0xE0,0xFF,0x2F,0xE0,0xFF,0x34,0xE0,0xFF,0x38,0xE0,0xFF,0x3B,0xE2,0x83,0x6E,0xE2,0x83,0x6E,0xE2,0x83,0x6E,0xE0,0xFF,0x3D,0xE0,0xFF,0x3B,0xE0,0xFF,0x38,0xE0,0xFF,0x34,0xE0,0xFF,0x2F,0xE0,0xFF,0x29,0xE0,0xFF,0x22,0xE0,0xFF,0x1B,0xE0,0xFF,0x11,0xE0,0xFF,0x09,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,
-    0xE0,0xFF,0x0A,0xE0,0xFF,0x14,0xE0,0xFF,0x1E,0xE0,0xFF,0x26,0xE0,0xFF,0x2E,0xE0,0xFF,0x35,0xE2,0x83,0x6D,0xE3,0x41,0xB8,0x44,0x31,0xE9,0x04,0x29,0xFF,0x04,0x29,0xFF,0x24,0x29,0xFF,0x24,0x29,0xFF,0x04,0x29,0xFF,0x44,0x31,0xE9,0x03,0x42,0xBA,0x02,0x84,0x71,0xE0,0xFF,0x3C,0xE0,0xFF,0x35,0xE0,0xFF,0x2E,0xE0,0xFF,0x26,0xE0,0xFF,0x1E,0xE0,0xFF,0x14,0xE0,0xFF,0x0A,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x0A,0xE0,0xFF,0x14,0xE0,0xFF,0x1F,0xE0,0xFF,0x29,0xE0,0xFF,0x32,0x62,0x94,0x5F,0x83,0x39,0xD0,0x04,0x29,0xFF,0xA3,0x39,0xFF,0x63,0x52,0xFF,0xE3,0x62,0xFF,0x62,0x73,0xFF,0x62,0x73,0xFF,0x62,0x73,0xFF,0x62,0x73,0xFF,0xE3,0x62,0xFF,0x63,0x52,0xFF,0xA3,0x39,0xFF,0xA3,0x39,0xD2,0xA2,0x9C,0x66,0xE0,0xFF,0x3A,0xE0,0xFF,0x32,0xE0,0xFF,0x29,0xE0,0xFF,0x1F,0xE0,0xFF,0x14,0xE0,0xFF,0x0A,0xFF,0xFF,0x00,0xFF,0xFF,0x00,
-    0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x08,0xE0,0xFF,0x13,0xE0,0xFF,0x1F,0xE0,0xFF,0x29,0xE0,0xFF,0x33,0xA3,0x5A,0x92,0x04,0x29,0xFF,0xA3,0x39,0xFF,0xE3,0x62,0xFF,0xA2,0x7B,0xFF,0x42,0x8C,0xFF,0xA2,0x9C,0xFF,0xE1,0xA4,0xFF,0x01,0xA5,0xFF,0x01,0xA5,0xFF,0xE1,0xA4,0xFF,0xA2,0x9C,0xFF,0x42,0x8C,0xFF,0xA2,0x7B,0xFF,0xE3,0x62,0xFF,0xA3,0x39,0xFF,0x83,0x52,0xA3,0xE0,0xFF,0x3D,0xE0,0xFF,0x34,0xE0,0xFF,0x2A,0xE0,0xFF,0x1F,0xE0,0xFF,0x13,0xE0,0xFF,0x08,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x04,0xE0,0xFF,0x10,0xE0,0xFF,0x1D,0xE0,0xFF,0x28,0xE0,0xFF,0x33,0xE3,0x41,0xB7,0x04,0x29,0xFF,0x43,0x52,0xFF,0x82,0x73,0xFF,0x62,0x94,0xFF,0x01,0xA5,0xFF,0x81,0xB5,0xFF,0xE1,0xBD,0xFF,0x01,0xC6,0xFF,0x21,0xCE,0xFF,0x21,0xCE,0xFF,0x01,0xC6,0xFF,0xE1,0xBD,0xFF,0x81,0xB5,0xFF,0x21,0xAD,0xFF,
-    0x62,0x94,0xFF,0x82,0x73,0xFF,0x43,0x52,0xFF,0x03,0x4A,0xBB,0xE0,0xFF,0x3E,0xE0,0xFF,0x33,0xE0,0xFF,0x28,0xE0,0xFF,0x1D,0xE0,0xFF,0x10,0xE0,0xFF,0x03,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x0B,0xE0,0xFF,0x19,0xE0,0xFF,0x25,0xE0,0xFF,0x31,0x63,0x52,0x9E,0x04,0x29,0xFF,0x83,0x52,0xFF,0xC2,0x7B,0xFF,0xE1,0x9C,0xFF,0x81,0xB5,0xFF,0x01,0xC6,0xFF,0x80,0xD6,0xFF,0xA0,0xDE,0xFF,0xE0,0xDE,0xFF,0xE0,0xDE,0xFF,0xE0,0xDE,0xFF,0xE0,0xDE,0xFF,0xA0,0xDE,0xFF,0x80,0xD6,0xFF,0x21,0xC6,0xFF,0xA1,0xB5,0xFF,0xE1,0x9C,0xFF,0xE2,0x83,0xFF,0x83,0x52,0xFF,0x83,0x5A,0xA4,0xE0,0xFF,0x3C,0xE0,0xFF,0x31,0xE0,0xFF,0x25,0xE0,0xFF,0x19,0xE0,0xFF,0x0C,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x05,0xE0,0xFF,0x12,0xE0,0xFF,0x20,0xE0,0xFF,0x2D,0xC2,0x7B,0x6B,0x04,0x29,0xFF,0x43,0x52,0xFF,0xE2,0x83,0xFF,0x01,0xA5,0xFF,0xC1,0xBD,0xFF,0x61,0xCE,0xFF,
-    0xC0,0xDE,0xFF,0x00,0xE7,0xFF,0x40,0xEF,0xFF,0x60,0xEF,0xFF,0x60,0xEF,0xFF,0x60,0xEF,0xFF,0x60,0xEF,0xFF,0x40,0xEF,0xFF,0x00,0xE7,0xFF,0xC0,0xDE,0xFF,0x61,0xCE,0xFF,0xC1,0xBD,0xFF,0x01,0xA5,0xFF,0xE2,0x83,0xFF,0x63,0x52,0xFF,0x22,0x8C,0x74,0xE0,0xFF,0x39,0xE0,0xFF,0x2D,0xE0,0xFF,0x20,0xE0,0xFF,0x12,0xE0,0xFF,0x04,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x0B,0xE0,0xFF,0x19,0xE0,0xFF,0x26,0xE0,0xFF,0x33,0x64,0x31,0xDC,0xC3,0x41,0xFF,0xA2,0x7B,0xFF,0xE1,0xA4,0xFF,0xC1,0xBD,0xFF,0x80,0xD6,0xFF,0xE0,0xE6,0xFF,0x40,0xEF,0xFF,0x60,0xEF,0xFF,0x80,0xF7,0xFF,0xA0,0xF7,0xFF,0xA0,0xF7,0xFF,0xA0,0xF7,0xFF,0xA0,0xF7,0xFF,0x80,0xF7,0xFF,0x60,0xEF,0xFF,0x40,0xEF,0xFF,0xE0,0xE6,0xFF,0x80,0xD6,0xFF,0xC1,0xBD,0xFF,0xE1,0xA4,0xFF,0xA2,0x7B,0xFF,0x03,0x4A,0xE9,0xE0,0xFF,0x40,0xE0,0xFF,0x34,0xE0,0xFF,0x27,0xE0,0xFF,0x19,0xE0,0xFF,0x0B,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x02,0xE0,0xFF,0x10,
-    0xE0,0xFF,0x1F,0xE0,0xFF,0x2C,0x62,0x73,0x78,0x04,0x29,0xFF,0xE3,0x62,0xFF,0x82,0x94,0xFF,0xA1,0xB5,0xFF,0x60,0xD6,0xFF,0xE0,0xE6,0xFF,0x40,0xEF,0xFF,0x80,0xF7,0xFF,0xA0,0xF7,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xA0,0xF7,0xFF,0x80,0xF7,0xFF,0x40,0xEF,0xFF,0xE0,0xE6,0xFF,0x60,0xD6,0xFF,0xA1,0xBD,0xFF,0x82,0x94,0xFF,0xE3,0x62,0xFF,0x22,0x6B,0x8C,0xE0,0xFF,0x3A,0xE0,0xFF,0x2C,0xE0,0xFF,0x1F,0xE0,0xFF,0x10,0xE0,0xFF,0x01,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x07,0xE0,0xFF,0x14,0xE0,0xFF,0x23,0xE0,0xFF,0x31,0xC3,0x39,0xC4,0xC3,0x41,0xFF,0xC2,0x7B,0xFF,0x21,0xAD,0xFF,0x21,0xCE,0xFF,0xC0,0xDE,0xFF,0x40,0xEF,0xFF,0x80,0xF7,0xFF,0xA0,0xFF,0xFF,0xC0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xC0,0xFF,0xFF,0xA0,0xFF,0xFF,0x80,0xF7,0xFF,0x40,0xEF,0xFF,0xC0,0xDE,0xFF,0x21,0xCE,0xFF,0x21,0xAD,0xFF,0xC2,0x7B,0xFF,0xA3,0x5A,0xC8,
-    0xE0,0xFF,0x3F,0xE0,0xFF,0x31,0xE0,0xFF,0x24,0xE0,0xFF,0x15,0xE0,0xFF,0x05,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x0A,0xE0,0xFF,0x19,0xE0,0xFF,0x27,0xE0,0xFF,0x35,0x04,0x29,0xFF,0xA3,0x5A,0xFF,0x62,0x94,0xFF,0xA1,0xBD,0xFF,0x80,0xD6,0xFF,0x20,0xE7,0xFF,0x60,0xF7,0xFF,0xA0,0xF7,0xFF,0xC0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xC0,0xFF,0xFF,0xA0,0xF7,0xFF,0x80,0xF7,0xFF,0x20,0xE7,0xFF,0x80,0xD6,0xFF,0xA1,0xBD,0xFF,0x62,0x94,0xFF,0xA3,0x5A,0xFF,0xE0,0xFF,0x43,0xE0,0xFF,0x35,0xE0,0xFF,0x27,0xE0,0xFF,0x19,0xE0,0xFF,0x09,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x0D,0xE0,0xFF,0x1C,0xE0,0xFF,0x2A,0x62,0x94,0x5D,0x04,0x29,0xFF,0x23,0x6B,0xFF,0xE1,0x9C,0xFF,0x01,0xC6,0xFF,0xC0,0xDE,0xFF,0x40,0xEF,0xFF,0x80,0xF7,0xFF,0xC0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,
-    0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xC0,0xFF,0xFF,0x80,0xF7,0xFF,0x40,0xEF,0xFF,0xC0,0xDE,0xFF,0x01,0xC6,0xFF,0xE1,0x9C,0xFF,0x42,0x6B,0xFF,0x22,0x8C,0x75,0xE0,0xFF,0x39,0xE0,0xFF,0x2A,0xE0,0xFF,0x1C,0xE0,0xFF,0x0D,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x0E,0xE0,0xFF,0x1E,0xE0,0xFF,0x2C,0xE2,0x83,0x6C,0x44,0x31,0xFF,0x82,0x73,0xFF,0x21,0xAD,0xFF,0x41,0xCE,0xFF,0xE0,0xDE,0xFF,0x60,0xEF,0xFF,0xA0,0xF7,0xFF,0xC0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xC0,0xFF,0xFF,0xA0,0xF7,0xFF,0x60,0xEF,0xFF,0xE0,0xE6,0xFF,0x41,0xCE,0xFF,0x21,0xAD,0xFF,0x82,0x73,0xFF,0x62,0x94,0x77,0xE0,0xFF,0x3B,0xE0,0xFF,0x2C,0xE0,0xFF,0x1E,0xE0,0xFF,0x0F,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x01,0xE0,0xFF,0x0F,0xE0,0xFF,0x1F,0xE0,0xFF,0x2D,0xE2,0x83,0x6D,0x83,0x39,0xFF,0xC2,0x7B,0xFF,0x41,0xAD,0xFF,0x41,0xCE,0xFF,0x00,0xE7,0xFF,
-    0x60,0xEF,0xFF,0xA0,0xF7,0xFF,0xC0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xC0,0xFF,0xFF,0xA0,0xF7,0xFF,0x60,0xEF,0xFF,0x00,0xE7,0xFF,0x41,0xCE,0xFF,0x41,0xAD,0xFF,0xC2,0x7B,0xFF,0x82,0x94,0x77,0xE0,0xFF,0x3C,0xE0,0xFF,0x2D,0xE0,0xFF,0x1F,0xE0,0xFF,0x0F,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x01,0xE0,0xFF,0x0F,0xE0,0xFF,0x1F,0xE0,0xFF,0x2D,0xE2,0x83,0x6D,0x83,0x39,0xFF,0xC2,0x7B,0xFF,0x41,0xAD,0xFF,0x41,0xCE,0xFF,0x00,0xE7,0xFF,0x60,0xF7,0xFF,0xA0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xA0,0xFF,0xFF,0x60,0xF7,0xFF,0x00,0xE7,0xFF,0x61,0xCE,0xFF,0x41,0xAD,0xFF,0xC2,0x7B,0xFF,0xA2,0x9C,0x78,0xE0,0xFF,0x3C,0xE0,0xFF,0x2E,0xE0,0xFF,0x1F,0xE0,0xFF,0x10,0xFF,0xFF,0x00,0xFF,0xFF,0x00,
-    0xFF,0xFF,0x00,0xE0,0xFF,0x0F,0xE0,0xFF,0x1E,0xE0,0xFF,0x2D,0xE2,0x83,0x6C,0x64,0x31,0xFF,0xA2,0x7B,0xFF,0x21,0xAD,0xFF,0x41,0xCE,0xFF,0x00,0xE7,0xFF,0x60,0xEF,0xFF,0xA0,0xF7,0xFF,0xC0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xC0,0xFF,0xFF,0xA0,0xF7,0xFF,0x60,0xEF,0xFF,0x00,0xE7,0xFF,0x41,0xCE,0xFF,0x21,0xAD,0xFF,0xA2,0x7B,0xFF,0x62,0x94,0x77,0xE0,0xFF,0x3B,0xE0,0xFF,0x2D,0xE0,0xFF,0x1E,0xE0,0xFF,0x0F,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x0D,0xE0,0xFF,0x1D,0xE0,0xFF,0x2B,0x61,0xCE,0x45,0x04,0x29,0xFF,0x62,0x73,0xFF,0xE1,0xA4,0xFF,0x01,0xC6,0xFF,0xC0,0xDE,0xFF,0x40,0xEF,0xFF,0xA0,0xF7,0xFF,0xC0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xC0,0xFF,0xFF,0xA0,0xF7,0xFF,0x40,0xEF,0xFF,0xE0,0xDE,0xFF,
-    0x01,0xC6,0xFF,0x01,0xA5,0xFF,0x62,0x73,0xFF,0xA0,0xD6,0x53,0xE0,0xFF,0x39,0xE0,0xFF,0x2B,0xE0,0xFF,0x1D,0xE0,0xFF,0x0D,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x0B,0xE0,0xFF,0x1A,0xE0,0xFF,0x28,0xE0,0xFF,0x36,0x64,0x31,0xDD,0xE3,0x62,0xFF,0x82,0x94,0xFF,0xC1,0xBD,0xFF,0xA0,0xD6,0xFF,0x20,0xE7,0xFF,0x80,0xF7,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0x80,0xF7,0xFF,0x20,0xE7,0xFF,0xA0,0xD6,0xFF,0xC1,0xBD,0xFF,0x82,0x94,0xFF,0x22,0x6B,0xDF,0xE0,0xFF,0x45,0xE0,0xFF,0x37,0xE0,0xFF,0x28,0xE0,0xFF,0x1A,0xE0,0xFF,0x09,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x08,0xE0,0xFF,0x16,0xE0,0xFF,0x25,0xE0,0xFF,0x33,0xC3,0x5A,0x94,0x23,0x4A,0xFF,0x02,0x84,0xFF,0x61,0xAD,0xFF,0x41,0xCE,0xFF,0xE0,0xDE,0xFF,0x40,0xEF,0xFF,0xA0,0xF7,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,
-    0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xA0,0xF7,0xFF,0x60,0xEF,0xFF,0xE0,0xE6,0xFF,0x41,0xCE,0xFF,0x61,0xAD,0xFF,0x02,0x84,0xFF,0xC2,0x7B,0x9C,0xE0,0xFF,0x41,0xE0,0xFF,0x33,0xE0,0xFF,0x25,0xE0,0xFF,0x16,0xE0,0xFF,0x05,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x04,0xE0,0xFF,0x12,0xE0,0xFF,0x20,0xE0,0xFF,0x2E,0x61,0xCE,0x47,0x44,0x31,0xF4,0x42,0x6B,0xFF,0xC2,0x9C,0xFF,0xC1,0xBD,0xFF,0x80,0xD6,0xFF,0x00,0xE7,0xFF,0x60,0xEF,0xFF,0xA0,0xF7,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xE0,0xFF,0xFF,0xE0,0xFF,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xA0,0xF7,0xFF,0x60,0xEF,0xFF,0x00,0xE7,0xFF,0x80,0xD6,0xFF,0xC1,0xBD,0xFF,0xC2,0x9C,0xFF,0x62,0x73,0xF5,0xA0,0xD6,0x54,0xE0,0xFF,0x3C,0xE0,0xFF,0x2E,0xE0,0xFF,0x21,0xE0,0xFF,0x12,0xE0,0xFF,0x01,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x0D,0xE0,0xFF,0x1B,0xE0,0xFF,0x28,0xE0,0xFF,0x36,0xC3,0x5A,0x95,
-    0x23,0x4A,0xFF,0xE2,0x83,0xFF,0x21,0xAD,0xFF,0x01,0xC6,0xFF,0xA0,0xD6,0xFF,0x00,0xE7,0xFF,0x60,0xEF,0xFF,0x80,0xF7,0xFF,0xA0,0xF7,0xFF,0xA0,0xFF,0xFF,0xC0,0xFF,0xFF,0xC0,0xFF,0xFF,0xA0,0xFF,0xFF,0xA0,0xF7,0xFF,0x80,0xF7,0xFF,0x60,0xEF,0xFF,0x00,0xE7,0xFF,0xA0,0xD6,0xFF,0x01,0xC6,0xFF,0x21,0xAD,0xFF,0xE2,0x83,0xFF,0xC2,0x7B,0x9D,0xE0,0xFF,0x43,0xE0,0xFF,0x36,0xE0,0xFF,0x29,0xE0,0xFF,0x1B,0xE0,0xFF,0x0B,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x07,0xE0,0xFF,0x14,0xE0,0xFF,0x22,0xE0,0xFF,0x2F,0xE0,0xFF,0x3B,0xA3,0x39,0xD2,0xC3,0x5A,0xFF,0x42,0x8C,0xFF,0x41,0xAD,0xFF,0x01,0xC6,0xFF,0x80,0xD6,0xFF,0x00,0xE7,0xFF,0x20,0xEF,0xFF,0x60,0xEF,0xFF,0x60,0xF7,0xFF,0x80,0xF7,0xFF,0x80,0xF7,0xFF,0x60,0xF7,0xFF,0x60,0xEF,0xFF,0x20,0xEF,0xFF,0x00,0xE7,0xFF,0x80,0xD6,0xFF,0x01,0xC6,0xFF,0x41,0xAD,0xFF,0x42,0x8C,0xFF,0x62,0x73,0xD5,0xE0,0xFF,0x48,0xE0,0xFF,0x3B,0xE0,0xFF,0x2F,0xE0,0xFF,0x22,0xE0,0xFF,0x14,0xE0,0xFF,0x03,
-    0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x01,0xE0,0xFF,0x0E,0xE0,0xFF,0x1B,0xE0,0xFF,0x27,0xE0,0xFF,0x33,0x80,0xD6,0x4B,0xA3,0x39,0xDE,0xE3,0x62,0xFF,0x42,0x8C,0xFF,0x21,0xAD,0xFF,0xE1,0xBD,0xFF,0x61,0xCE,0xFF,0xA0,0xDE,0xFF,0xE0,0xDE,0xFF,0x00,0xE7,0xFF,0x20,0xE7,0xFF,0x20,0xE7,0xFF,0x00,0xE7,0xFF,0xE0,0xDE,0xFF,0xA0,0xDE,0xFF,0x61,0xCE,0xFF,0xE1,0xBD,0xFF,0x21,0xAD,0xFF,0x42,0x8C,0xFF,0x62,0x73,0xE0,0xC0,0xDE,0x56,0xE0,0xFF,0x3F,0xE0,0xFF,0x34,0xE0,0xFF,0x28,0xE0,0xFF,0x1B,0xE0,0xFF,0x0C,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x06,0xE0,0xFF,0x13,0xE0,0xFF,0x1F,0xE0,0xFF,0x2B,0xE0,0xFF,0x36,0x80,0xD6,0x4D,0xA3,0x39,0xDE,0xE3,0x62,0xFF,0x02,0x84,0xFF,0xE1,0x9C,0xFF,0x61,0xB5,0xFF,0xE1,0xBD,0xFF,0x21,0xCE,0xFF,0x61,0xCE,0xFF,0x80,0xD6,0xFF,0x80,0xD6,0xFF,0x61,0xCE,0xFF,0x21,0xCE,0xFF,0xE1,0xBD,0xFF,0x61,0xB5,0xFF,0xE1,0x9C,0xFF,
-    0x02,0x84,0xFF,0x42,0x6B,0xE0,0xC0,0xDE,0x56,0xE0,0xFF,0x41,0xE0,0xFF,0x36,0xE0,0xFF,0x2B,0xE0,0xFF,0x20,0xE0,0xFF,0x13,0xE0,0xFF,0x02,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x0A,0xE0,0xFF,0x16,0xE0,0xFF,0x22,0xE0,0xFF,0x2D,0xE0,0xFF,0x37,0xE0,0xFF,0x40,0x83,0x5A,0xA5,0x43,0x52,0xFF,0x62,0x73,0xFF,0x22,0x8C,0xFF,0xA2,0x9C,0xFF,0x21,0xAD,0xFF,0x61,0xAD,0xFF,0x81,0xB5,0xFF,0x81,0xB5,0xFF,0x61,0xAD,0xFF,0x21,0xAD,0xFF,0xA2,0x9C,0xFF,0x22,0x8C,0xFF,0x62,0x73,0xFF,0xC2,0x7B,0xA9,0xE0,0xFF,0x4A,0xE0,0xFF,0x41,0xE0,0xFF,0x37,0xE0,0xFF,0x2D,0xE0,0xFF,0x22,0xE0,0xFF,0x16,0xE0,0xFF,0x06,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x01,0xE0,0xFF,0x0D,0xE0,0xFF,0x18,0xE0,0xFF,0x23,0xE0,0xFF,0x2C,0xE0,0xFF,0x35,0xE0,0xFF,0x3E,0x81,0xB5,0x5D,0xA3,0x5A,0xB2,0x83,0x52,0xF5,
-    0x03,0x63,0xFF,0x82,0x73,0xFF,0xE2,0x83,0xFF,0x02,0x84,0xFF,0x02,0x84,0xFF,0xE2,0x83,0xFF,0xA2,0x7B,0xFF,0x23,0x6B,0xF5,0x82,0x73,0xB5,0xE1,0xBD,0x63,0xE0,0xFF,0x46,0xE0,0xFF,0x3E,0xE0,0xFF,0x36,0xE0,0xFF,0x2C,0xE0,0xFF,0x23,0xE0,0xFF,0x18,0xE0,0xFF,0x08,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x02,0xE0,0xFF,0x0D,0xE0,0xFF,0x18,0xE0,0xFF,0x21,0xE0,0xFF,0x2A,0xE0,0xFF,0x32,0xE0,0xFF,0x39,0xE0,0xFF,0x40,0xE0,0xFF,0x45,0xE1,0xA4,0x6C,0xA2,0x7B,0x91,0x42,0x6B,0xA8,0x82,0x73,0xA9,0x82,0x73,0xA9,0xE2,0x83,0x93,0x21,0xAD,0x70,0xE0,0xFF,0x4A,0xE0,0xFF,0x45,0xE0,0xFF,0x40,0xE0,0xFF,0x39,0xE0,0xFF,0x32,0xE0,0xFF,0x2A,0xE0,0xFF,0x21,0xE0,0xFF,0x18,0xE0,0xFF,0x09,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,
-    0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x02,0xE0,0xFF,0x0C,0xE0,0xFF,0x15,0xE0,0xFF,0x1E,0xE0,0xFF,0x26,0xE0,0xFF,0x2D,0xE0,0xFF,0x33,0xE0,0xFF,0x38,0xE0,0xFF,0x3C,0xE0,0xFF,0x40,0xE0,0xFF,0x42,0xE0,0xFF,0x43,0xE0,0xFF,0x43,0xE0,0xFF,0x42,0xE0,0xFF,0x40,0xE0,0xFF,0x3C,0xE0,0xFF,0x38,0xE0,0xFF,0x33,0xE0,0xFF,0x2D,0xE0,0xFF,0x26,0xE0,0xFF,0x1E,0xE0,0xFF,0x15,0xE0,0xFF,0x07,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x09,0xE0,0xFF,0x11,0xE0,0xFF,0x1A,0xE0,0xFF,0x20,0xE0,0xFF,0x26,0xE0,0xFF,0x2B,0xE0,0xFF,0x2F,0xE0,0xFF,0x32,0xE0,0xFF,0x34,0xE0,0xFF,0x35,0xE0,0xFF,0x35,0xE0,0xFF,0x34,0xE0,0xFF,0x32,0xE0,0xFF,0x2F,0xE0,0xFF,0x2B,0xE0,0xFF,0x26,0xE0,0xFF,0x20,0xE0,0xFF,0x1A,0xE0,0xFF,0x10,0xE0,0xFF,0x03,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,
-    0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x03,0xE0,0xFF,0x0B,0xE0,0xFF,0x12,0xE0,0xFF,0x19,0xE0,0xFF,0x1D,0xE0,0xFF,0x21,0xE0,0xFF,0x24,0xE0,0xFF,0x26,0xE0,0xFF,0x27,0xE0,0xFF,0x27,0xE0,0xFF,0x26,0xE0,0xFF,0x24,0xE0,0xFF,0x21,0xE0,0xFF,0x1D,0xE0,0xFF,0x19,0xE0,0xFF,0x11,0xE0,0xFF,0x06,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x02,0xE0,0xFF,0x07,0xE0,0xFF,0x0E,0xE0,0xFF,0x12,0xE0,0xFF,0x15,0xE0,0xFF,0x18,0xE0,0xFF,0x18,0xE0,0xFF,0x19,0xE0,0xFF,0x18,0xE0,0xFF,0x15,
-    0xE0,0xFF,0x11,0xE0,0xFF,0x0A,0xE0,0xFF,0x04,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xE0,0xFF,0x01,0xE0,0xFF,0x02,0xE0,0xFF,0x02,0xE0,0xFF,0x02,0xE0,0xFF,0x02,0xE0,0xFF,0x02,0xE0,0xFF,0x01,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,0xFF,0xFF,0x00,
-};
-const lv_img_dsc_t ui_img_dot_asset_2_png = {
-    {
-        LV_IMG_CF_TRUE_COLOR_ALPHA,
-        0,
-        0,
-        37,
-        36
-    },
-    sizeof(ui_img_dot_asset_2_png_data),
-    ui_img_dot_asset_2_png_data
-};
-